@@ -11,6 +11,10 @@ include(FetchContent)
 include(CMakeDependentOption)
 set(FETCH_PACKAGES "")
 
+# the DD package uses threads for parallel functionality construction
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_package(Threads REQUIRED)
+
 if(BUILD_MQT_CORE_BINDINGS)
   if(NOT SKBUILD)
     # Manually detect the installed pybind11 package and import it into CMake.
@@ -94,5 +98,28 @@ if(BUILD_MQT_CORE_TESTS)
   endif()
 endif()
 
+if(BUILD_MQT_CORE_BENCHMARKS)
+  set(BENCHMARK_ENABLE_TESTING
+      OFF
+      CACHE INTERNAL "Disable the tests of Google Benchmark")
+  set(BENCHMARK_ENABLE_INSTALL
+      OFF
+      CACHE INTERNAL "Disable the installation of Google Benchmark")
+  set(BENCHMARK_VERSION
+      1.8.3
+      CACHE STRING "Google Benchmark version")
+  set(BENCHMARK_URL https://github.com/google/benchmark/archive/refs/tags/v${BENCHMARK_VERSION}.tar.gz)
+  if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.24)
+    FetchContent_Declare(benchmark URL ${BENCHMARK_URL} FIND_PACKAGE_ARGS 1.7)
+    list(APPEND FETCH_PACKAGES benchmark)
+  else()
+    find_package(benchmark 1.7 QUIET)
+    if(NOT benchmark_FOUND)
+      FetchContent_Declare(benchmark URL ${BENCHMARK_URL})
+      list(APPEND FETCH_PACKAGES benchmark)
+    endif()
+  endif()
+endif()
+
 # Make all declared dependencies available.
 FetchContent_MakeAvailable(${FETCH_PACKAGES})
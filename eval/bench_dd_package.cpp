@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "algorithms/QFT.hpp"
+#include "dd/CachedEdge.hpp"
+#include "dd/Complex.hpp"
+#include "dd/ComputeTable.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/DDpackageConfig.hpp"
+#include "dd/FunctionalityConstruction.hpp"
+#include "dd/GateMatrixDefinitions.hpp"
+#include "dd/MemoryManager.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package.hpp"
+#include "dd/RealNumber.hpp"
+#include "dd/RealNumberUniqueTable.hpp"
+#include "dd/Simulation.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace dd {
+
+namespace {
+
+constexpr std::uint64_t SEED = 42U;
+
+template <class Config>
+vEdge randomState(Package<Config>& dd, const std::size_t nqubits,
+                  std::mt19937_64& mt) {
+  std::normal_distribution<fp> dist{};
+  CVec amplitudes(1ULL << nqubits);
+  fp norm = 0.;
+  for (auto& amplitude : amplitudes) {
+    amplitude = {dist(mt), dist(mt)};
+    norm += std::norm(amplitude);
+  }
+  for (auto& amplitude : amplitudes) {
+    amplitude /= std::sqrt(norm);
+  }
+  return dd.makeStateFromVector(amplitudes);
+}
+
+template <class Config>
+mEdge qftFunctionality(Package<Config>& dd, const std::size_t nqubits) {
+  const auto qc = qc::QFT(nqubits, false);
+  return buildFunctionality(&qc, dd);
+}
+
+std::size_t qubits(const benchmark::State& state) {
+  return static_cast<std::size_t>(state.range(0));
+}
+
+/// Report the real number table lookups per iteration (always zero if the
+/// profiling counters are disabled)
+template <class Config>
+void reportLookups(benchmark::State& state, const Package<Config>& dd,
+                   const std::size_t before) {
+  const std::size_t after = dd.cUniqueTable.getStats().lookups;
+  state.counters["lookups"] =
+      benchmark::Counter(static_cast<double>(after - before),
+                         benchmark::Counter::kAvgIterations);
+}
+
+///
+/// Node creation and tables
+///
+
+template <class Config> void makeDDNode(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  for (auto _ : state) {
+    // after the first iteration, every node is found in the unique table
+    auto e = vEdge::one();
+    for (std::size_t q = 0U; q < nqubits; ++q) {
+      e = dd->makeDDNode(static_cast<Qubit>(q), std::array{e, vEdge::zero()});
+    }
+    benchmark::DoNotOptimize(e);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(nqubits));
+}
+
+void realNumberLookup(benchmark::State& state) {
+  const auto distinct = static_cast<std::size_t>(state.range(0));
+  MemoryManager<RealNumber> memoryManager{};
+  RealNumberUniqueTable table{memoryManager};
+  std::mt19937_64 mt(SEED);
+  std::uniform_real_distribution<fp> dist(0., 1.);
+  std::vector<fp> values(distinct);
+  for (auto& value : values) {
+    value = dist(mt);
+  }
+  std::size_t i = 0U;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.lookup(values[i]));
+    i = (i + 1U == distinct) ? 0U : i + 1U;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <std::size_t NBUCKET>
+void computeTableInsert(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<>>(nqubits);
+  const auto lhs = dd->makeGateDD(H_MAT, 0U);
+  const auto rhs = dd->makeZeroState(nqubits);
+  ComputeTable<mEdge, vEdge, vCachedEdge, NBUCKET> table{};
+  const auto result = vCachedEdge{rhs.p, Complex::one()};
+  for (auto _ : state) {
+    table.insert(lhs, rhs, result);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <std::size_t NBUCKET>
+void computeTableLookup(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<>>(nqubits);
+  std::vector<mEdge> gates{};
+  for (std::size_t q = 0U; q < nqubits; ++q) {
+    gates.emplace_back(dd->makeGateDD(H_MAT, static_cast<Qubit>(q)));
+  }
+  const auto rhs = dd->makeZeroState(nqubits);
+  ComputeTable<mEdge, vEdge, vCachedEdge, NBUCKET> table{};
+  const auto result = vCachedEdge{rhs.p, Complex::one()};
+  // only every other gate is stored, i.e., half of the lookups miss
+  for (std::size_t q = 0U; q < nqubits; q += 2U) {
+    table.insert(gates[q], rhs, result);
+  }
+  std::size_t i = 0U;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.lookup(gates[i], rhs));
+    i = (i + 1U == nqubits) ? 0U : i + 1U;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void memoryManagerGet(benchmark::State& state) {
+  const auto entries = static_cast<std::size_t>(state.range(0));
+  MemoryManager<vNode> memoryManager{};
+  std::vector<vNode*> nodes(entries);
+  for (auto _ : state) {
+    for (auto& node : nodes) {
+      node = memoryManager.get();
+    }
+    benchmark::DoNotOptimize(nodes.data());
+    // entries are returned so that later iterations reuse them
+    for (auto* node : nodes) {
+      memoryManager.returnEntry(node);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(entries));
+}
+
+///
+/// Operations
+///
+
+template <class Config> void matrixVectorMultiply(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  std::mt19937_64 mt(SEED);
+  const auto in = randomState(*dd, nqubits, mt);
+  const auto gate = dd->makeGateDD(H_MAT, static_cast<Qubit>(nqubits - 1U));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->multiply(gate, in));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    state.ResumeTiming();
+  }
+}
+
+template <class Config> void matrixMatrixMultiply(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  const auto qft = qftFunctionality(*dd, nqubits);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->multiply(qft, qft));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    state.ResumeTiming();
+  }
+}
+
+template <class Config> void vectorAdd(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  std::mt19937_64 mt(SEED);
+  const auto x = randomState(*dd, nqubits, mt);
+  const auto y = randomState(*dd, nqubits, mt);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->add(x, y));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    state.ResumeTiming();
+  }
+}
+
+template <class Config> void matrixAdd(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  const auto qft = qftFunctionality(*dd, nqubits);
+  const auto ident = dd->makeIdent();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->add(qft, ident));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    state.ResumeTiming();
+  }
+}
+
+template <class Config> void vectorKronecker(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  const auto half = nqubits / 2U;
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  std::mt19937_64 mt(SEED);
+  const auto x = randomState(*dd, nqubits - half, mt);
+  const auto y = randomState(*dd, half, mt);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->kronecker(x, y, half));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    state.ResumeTiming();
+  }
+}
+
+template <class Config> void measureAll(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  std::mt19937_64 mt(SEED);
+  auto in = randomState(*dd, nqubits, mt);
+  const std::size_t lookups = dd->cUniqueTable.getStats().lookups;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->measureAll(in, false, mt));
+  }
+  reportLookups(state, *dd, lookups);
+}
+
+template <class Config> void measureOneQubit(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  std::mt19937_64 mt(SEED);
+  auto in = randomState(*dd, nqubits, mt);
+  dd->incRef(in);
+  const auto target = static_cast<Qubit>(nqubits / 2U);
+  const std::size_t lookups = dd->cUniqueTable.getStats().lookups;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->measureOneQubit(in, target));
+    state.PauseTiming();
+    dd->clearComputeTables();
+    state.ResumeTiming();
+  }
+  reportLookups(state, *dd, lookups);
+}
+
+template <class Config> void transfer(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto source = std::make_unique<Package<Config>>(nqubits);
+  std::mt19937_64 mt(SEED);
+  auto in = randomState(*source, nqubits, mt);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  const std::size_t lookups = dd->cUniqueTable.getStats().lookups;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dd->transfer(in));
+  }
+  reportLookups(state, *dd, lookups);
+}
+
+template <class Config> void garbageCollect(benchmark::State& state) {
+  const auto nqubits = qubits(state);
+  auto dd = std::make_unique<Package<Config>>(nqubits);
+  std::mt19937_64 mt(SEED);
+  for (auto _ : state) {
+    state.PauseTiming();
+    const auto e = randomState(*dd, nqubits, mt);
+    dd->decRef(e);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(dd->garbageCollect(true));
+  }
+}
+
+///
+/// Simulation
+///
+
+/// A batch of states that only differ in the most significant qubit, i.e.,
+/// that share all sub-DDs below it
+template <class Config>
+std::vector<vEdge> sharedStates(Package<Config>& dd, const std::size_t nqubits,
+                                const std::size_t size) {
+  std::mt19937_64 mt(SEED);
+  const auto rest = randomState(dd, nqubits - 1U, mt);
+  dd.incRef(rest);
+  std::vector<vEdge> states{};
+  for (std::size_t i = 0U; i < size; ++i) {
+    const auto top = randomState(dd, 1U, mt);
+    states.emplace_back(dd.kronecker(top, rest, nqubits - 1U));
+    dd.incRef(states.back());
+  }
+  dd.decRef(rest);
+  return states;
+}
+
+constexpr std::size_t SIMULATION_QUBITS = 10U;
+
+template <class Config> void simulateBatch(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<Config>>(SIMULATION_QUBITS);
+  const auto qc = qc::QFT(SIMULATION_QUBITS, false);
+  const auto in = sharedStates(*dd, SIMULATION_QUBITS, size);
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (const auto& e : in) {
+      dd->incRef(e);
+    }
+    state.ResumeTiming();
+    const auto out = simulate(&qc, in, *dd);
+    state.PauseTiming();
+    for (const auto& e : out) {
+      dd->decRef(e);
+    }
+    dd->clearComputeTables();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(size));
+}
+
+template <class Config> void simulateSeparately(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  auto dd = std::make_unique<Package<Config>>(SIMULATION_QUBITS);
+  const auto qc = qc::QFT(SIMULATION_QUBITS, false);
+  const auto in = sharedStates(*dd, SIMULATION_QUBITS, size);
+  for (auto _ : state) {
+    for (const auto& e : in) {
+      dd->incRef(e);
+      const auto out = simulate(&qc, e, *dd);
+      state.PauseTiming();
+      dd->decRef(out);
+      state.ResumeTiming();
+    }
+    state.PauseTiming();
+    dd->clearComputeTables();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(size));
+}
+
+} // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-owning-memory)
+BENCHMARK_TEMPLATE(makeDDNode, DDPackageConfig)
+    ->RangeMultiplier(2)
+    ->Range(8, 128);
+BENCHMARK_TEMPLATE(makeDDNode, StochasticNoiseSimulatorDDPackageConfig)
+    ->RangeMultiplier(2)
+    ->Range(8, 128);
+BENCHMARK(realNumberLookup)->RangeMultiplier(16)->Range(16, 1U << 16U);
+BENCHMARK_TEMPLATE(computeTableInsert, 4096U)->Arg(16);
+BENCHMARK_TEMPLATE(computeTableInsert, 16384U)->Arg(16);
+BENCHMARK_TEMPLATE(computeTableLookup, 4096U)->Arg(16);
+BENCHMARK_TEMPLATE(computeTableLookup, 16384U)->Arg(16);
+BENCHMARK(memoryManagerGet)->RangeMultiplier(16)->Range(256, 1U << 16U);
+
+BENCHMARK_TEMPLATE(matrixVectorMultiply, DDPackageConfig)
+    ->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(matrixVectorMultiply,
+                   StochasticNoiseSimulatorDDPackageConfig)
+    ->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(matrixMatrixMultiply, DDPackageConfig)->DenseRange(2, 6, 2);
+BENCHMARK_TEMPLATE(matrixMatrixMultiply, UnitarySimulatorDDPackageConfig)
+    ->DenseRange(2, 6, 2);
+BENCHMARK_TEMPLATE(vectorAdd, DDPackageConfig)->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(vectorAdd, StochasticNoiseSimulatorDDPackageConfig)
+    ->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(matrixAdd, DDPackageConfig)->DenseRange(3, 9, 3);
+BENCHMARK_TEMPLATE(matrixAdd, UnitarySimulatorDDPackageConfig)
+    ->DenseRange(3, 9, 3);
+BENCHMARK_TEMPLATE(vectorKronecker, DDPackageConfig)->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(measureAll, DDPackageConfig)->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(measureAll, StochasticNoiseSimulatorDDPackageConfig)
+    ->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(measureOneQubit, DDPackageConfig)->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(transfer, DDPackageConfig)->DenseRange(4, 12, 4);
+BENCHMARK_TEMPLATE(garbageCollect, DDPackageConfig)->DenseRange(4, 16, 4);
+BENCHMARK_TEMPLATE(garbageCollect, StochasticNoiseSimulatorDDPackageConfig)
+    ->DenseRange(4, 16, 4);
+
+BENCHMARK_TEMPLATE(simulateBatch, DDPackageConfig)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(simulateSeparately, DDPackageConfig)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-owning-memory)
+
+} // namespace dd
+
+BENCHMARK_MAIN();
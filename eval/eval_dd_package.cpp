@@ -15,13 +15,14 @@
 #include "algorithms/RandomCliffordCircuit.hpp"
 #include "algorithms/WState.hpp"
 #include "circuit_optimizer/CircuitOptimizer.hpp"
+#include "dd/DDpackageConfig.hpp"
 #include "dd/FunctionalityConstruction.hpp"
 #include "dd/Package.hpp"
 #include "dd/Simulation.hpp"
 #include "dd/statistics/PackageStatistics.hpp"
 #include "ir/QuantumComputation.hpp"
 
-#include <array>
+#include <algorithm>
 #include <bitset>
 #include <chrono>
 #include <cmath>
@@ -32,43 +33,114 @@
 #include <iostream>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace dd {
 
-struct Experiment {
-  std::unique_ptr<Package<>> dd;
-  nlohmann::basic_json<> stats = nlohmann::basic_json<>::object();
-  std::chrono::duration<double> runtime{};
+/// Version of the results (and baseline) files written by the runner
+static constexpr std::size_t RESULTS_FORMAT_VERSION = 1U;
 
-  Experiment() = default;
-  Experiment(const Experiment&) = delete;
-  Experiment(Experiment&&) = default;
-  Experiment& operator=(const Experiment&) = delete;
-  Experiment& operator=(Experiment&&) = default;
-  virtual ~Experiment() = default;
+static constexpr std::size_t SEED = 42U;
 
-  [[nodiscard]] virtual bool success() const noexcept { return false; }
+/// A benchmark of one algorithm and task for a range of qubit counts
+struct BenchmarkSpec {
+  /// One of GHZ, WState, BV, QFT, Grover, QPE, RandomClifford
+  std::string algorithm;
+  /// Either Simulation or Functionality
+  std::string task;
+  std::vector<std::size_t> qubits;
+  /// The package configuration preset (default or unitary)
+  std::string config = "default";
 };
 
-struct SimulationExperiment final : public Experiment {
-  SimulationExperiment() = default;
-  qc::VectorDD sim{};
-
-  [[nodiscard]] bool success() const noexcept override {
-    return sim.p != nullptr;
+/**
+ * @brief A set of benchmarks together with the measurement setup
+ * @details Suites can be read from JSON files of the form
+ * ```json
+ * {
+ *   "name": "smoke",
+ *   "warmup": 1,
+ *   "repetitions": 5,
+ *   "benchmarks": [
+ *     {"algorithm": "QFT", "task": "Simulation", "qubits": [64, 128]},
+ *     {"algorithm": "QFT", "task": "Functionality", "qubits": [8],
+ *      "config": "unitary"}
+ *   ]
+ * }
+ * ```
+ */
+struct BenchmarkSuite {
+  std::string name = "default";
+  /// Number of unmeasured runs before the measurements
+  std::size_t warmup = 0U;
+  /// Number of measured runs
+  std::size_t repetitions = 1U;
+  std::vector<BenchmarkSpec> benchmarks;
+
+  static BenchmarkSuite fromJSON(const nlohmann::basic_json<>& j) {
+    BenchmarkSuite suite{};
+    suite.name = j.value("name", suite.name);
+    suite.warmup = j.value("warmup", suite.warmup);
+    suite.repetitions = j.value("repetitions", suite.repetitions);
+    if (suite.repetitions == 0U) {
+      throw std::invalid_argument("At least one repetition is required.");
+    }
+    for (const auto& b : j.at("benchmarks")) {
+      BenchmarkSpec spec{};
+      spec.algorithm = b.at("algorithm").get<std::string>();
+      spec.task = b.at("task").get<std::string>();
+      spec.qubits = b.at("qubits").get<std::vector<std::size_t>>();
+      spec.config = b.value("config", spec.config);
+      suite.benchmarks.emplace_back(std::move(spec));
+    }
+    return suite;
   }
-};
 
-struct FunctionalityConstructionExperiment final : public Experiment {
-  qc::MatrixDD func{};
+  static BenchmarkSuite fromFile(const std::string& filename) {
+    std::ifstream ifs(filename);
+    if (!ifs.good()) {
+      throw std::invalid_argument("Cannot open suite file: " + filename);
+    }
+    return fromJSON(nlohmann::json::parse(ifs));
+  }
 
-  [[nodiscard]] bool success() const noexcept override {
-    return func.p != nullptr;
+  /// The suite that was historically hard-coded into this runner
+  static BenchmarkSuite defaultSuite() {
+    BenchmarkSuite suite{};
+    const std::vector<std::size_t> large = {256U, 512U, 1024U, 2048U, 4096U};
+    const std::vector<std::size_t> bv = {255U, 511U, 1023U, 2047U, 4095U};
+    const std::vector<std::size_t> medium = {14U, 15U, 16U, 17U, 18U};
+    const std::vector<std::size_t> small = {7U, 8U, 9U, 10U, 11U};
+    suite.benchmarks = {
+        {"GHZ", "Simulation", large},
+        {"GHZ", "Functionality", large},
+        {"WState", "Simulation", large},
+        {"WState", "Functionality", large},
+        {"BV", "Simulation", bv},
+        {"BV", "Functionality", bv},
+        {"QFT", "Simulation", large},
+        {"QFT", "Functionality", {18U, 19U, 20U, 21U, 22U}},
+        {"Grover", "Simulation", {27U, 31U, 35U, 39U, 41U}},
+        {"Grover", "Functionality", {27U, 31U, 35U, 39U, 41U}},
+        {"QPE", "Simulation", medium},
+        {"QPE", "Functionality", small},
+        {"RandomClifford", "Simulation", medium},
+        {"RandomClifford", "Functionality", small},
+    };
+    return suite;
   }
 };
 
+/// The outcome of a single run of a benchmark
+struct Measurement {
+  double runtime = 0.;
+  double peakMemoryMiB = 0.;
+  nlohmann::basic_json<> stats = nlohmann::basic_json<>::object();
+};
+
 namespace {
 template <class Config>
 MatrixDD buildFunctionality(const qc::Grover* qc, Package<Config>& dd) {
@@ -130,276 +202,331 @@ MatrixDD buildFunctionalityRecursive(const qc::Grover* qc,
   return dd.applyOperation(e, s);
 }
 
-std::unique_ptr<SimulationExperiment>
-benchmarkSimulate(const QuantumComputation& qc) {
-  auto exp = std::make_unique<SimulationExperiment>();
-  const auto nq = qc.getNqubits();
-  exp->dd = std::make_unique<Package<>>(nq);
-  const auto start = std::chrono::high_resolution_clock::now();
-  const auto in = exp->dd->makeZeroState(nq);
-  exp->sim = simulate(&qc, in, *(exp->dd));
-  const auto end = std::chrono::high_resolution_clock::now();
-  exp->runtime =
-      std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
-  exp->stats = dd::getStatistics(exp->dd.get());
-  return exp;
+template <class Config>
+VectorDD simulate(const qc::Grover* qc, Package<Config>& dd) {
+  // apply state preparation setup
+  qc::QuantumComputation statePrep(qc->getNqubits());
+  qc->setup(statePrep);
+  auto s = buildFunctionality(&statePrep, dd);
+  auto e = dd.applyOperation(s, dd.makeZeroState(qc->getNqubits()));
+
+  qc::QuantumComputation groverIteration(qc->getNqubits());
+  qc->oracle(groverIteration);
+  qc->diffusion(groverIteration);
+
+  auto iter = buildFunctionalityRecursive(&groverIteration, dd);
+  std::bitset<128U> iterBits(qc->iterations);
+  const auto msb =
+      static_cast<std::size_t>(std::floor(std::log2(qc->iterations)));
+  auto f = iter;
+  dd.incRef(f);
+  for (std::size_t j = 0U; j <= msb; ++j) {
+    if (iterBits[j]) {
+      e = dd.applyOperation(f, e);
+    }
+    if (j < msb) {
+      f = dd.applyOperation(f, f);
+    }
+  }
+  dd.decRef(f);
+  return e;
+}
+
+std::unique_ptr<QuantumComputation> makeCircuit(const std::string& algorithm,
+                                                const std::size_t nq) {
+  std::unique_ptr<QuantumComputation> qc;
+  if (algorithm == "GHZ") {
+    qc = std::make_unique<qc::Entanglement>(nq);
+  } else if (algorithm == "WState") {
+    qc = std::make_unique<qc::WState>(nq);
+  } else if (algorithm == "BV") {
+    qc = std::make_unique<qc::BernsteinVazirani>(nq);
+  } else if (algorithm == "QFT") {
+    qc = std::make_unique<qc::QFT>(nq, false);
+  } else if (algorithm == "Grover") {
+    qc = std::make_unique<qc::Grover>(nq, SEED);
+  } else if (algorithm == "QPE") {
+    qc = std::make_unique<qc::QPE>(nq, false);
+  } else if (algorithm == "RandomClifford") {
+    qc = std::make_unique<qc::RandomCliffordCircuit>(nq, nq * nq, SEED);
+  } else {
+    throw std::invalid_argument("Unknown algorithm: " + algorithm);
+  }
+  qc::CircuitOptimizer::removeFinalMeasurements(*qc);
+  return qc;
 }
 
-std::unique_ptr<FunctionalityConstructionExperiment>
-benchmarkFunctionalityConstruction(const QuantumComputation& qc,
-                                   const bool recursive = false) {
-  auto exp = std::make_unique<FunctionalityConstructionExperiment>();
+template <class Config>
+Measurement runOnce(const std::string& task, const QuantumComputation& qc) {
+  if (task != "Simulation" && task != "Functionality") {
+    throw std::invalid_argument("Unknown task: " + task);
+  }
   const auto nq = qc.getNqubits();
-  exp->dd = std::make_unique<Package<>>(nq);
-  const auto start = std::chrono::high_resolution_clock::now();
+  auto dd = std::make_unique<Package<Config>>(nq);
+  const auto* grover = dynamic_cast<const qc::Grover*>(&qc);
 
-  if (const auto* grover = dynamic_cast<const Grover*>(&qc)) {
-    if (recursive) {
-      exp->func = buildFunctionalityRecursive(grover, *(exp->dd));
+  const auto start = std::chrono::high_resolution_clock::now();
+  if (task == "Simulation") {
+    if (grover != nullptr) {
+      static_cast<void>(simulate(grover, *dd));
     } else {
-      exp->func = buildFunctionality(grover, *(exp->dd));
+      static_cast<void>(dd::simulate(&qc, dd->makeZeroState(nq), *dd));
     }
   } else {
-    if (recursive) {
-      exp->func = buildFunctionalityRecursive(&qc, *(exp->dd));
+    if (grover != nullptr) {
+      static_cast<void>(buildFunctionalityRecursive(grover, *dd));
     } else {
-      exp->func = buildFunctionality(&qc, *(exp->dd));
+      static_cast<void>(buildFunctionality(&qc, *dd));
     }
   }
   const auto end = std::chrono::high_resolution_clock::now();
-  exp->runtime =
-      std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
-  exp->stats = dd::getStatistics(exp->dd.get());
-  return exp;
-}
-} // namespace
 
-static constexpr std::size_t SEED = 42U;
-
-class BenchmarkDDPackage {
-protected:
-  void verifyAndSave(const std::string& name, const std::string& type,
-                     qc::QuantumComputation& qc, const Experiment& exp) const {
-
-    const std::string& filename = "results_" + inputFilename + ".json";
-
-    nlohmann::basic_json<> j;
-    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::ate);
-    if (!file.is_open()) {
-      std::ofstream outputFile(filename);
-      outputFile << nlohmann::json();
-    } else if (file.tellg() == 0) {
-      file << nlohmann::json();
-    }
-    file.close();
-
-    std::ifstream ifs(filename);
-    ifs >> j;
-    ifs.close();
-
-    auto& entry = j[name][type][std::to_string(qc.getNqubits())];
+  Measurement m{};
+  m.runtime =
+      std::chrono::duration_cast<std::chrono::duration<double>>(end - start)
+          .count();
+  m.peakMemoryMiB = computePeakMemoryMiB(dd.get());
+  m.stats = getStatistics(dd.get());
+  return m;
+}
 
-    entry["runtime"] = exp.runtime.count();
+Measurement runOnce(const BenchmarkSpec& spec, const QuantumComputation& qc) {
+  if (spec.config == "default") {
+    return runOnce<DDPackageConfig>(spec.task, qc);
+  }
+  if (spec.config == "unitary") {
+    return runOnce<UnitarySimulatorDDPackageConfig>(spec.task, qc);
+  }
+  throw std::invalid_argument("Unknown package configuration: " + spec.config);
+}
 
-    // collect statistics from DD package
-    entry["dd"] = exp.stats;
+/// The p-th percentile (0 <= p <= 1) of sorted values (linear interpolation)
+double percentile(const std::vector<double>& sorted, const double p) {
+  const auto pos = p * static_cast<double>(sorted.size() - 1U);
+  const auto lower = static_cast<std::size_t>(std::floor(pos));
+  const auto upper = std::min(lower + 1U, sorted.size() - 1U);
+  const auto fraction = pos - static_cast<double>(lower);
+  return sorted[lower] + (fraction * (sorted[upper] - sorted[lower]));
+}
 
-    std::ofstream ofs(filename);
-    ofs << j.dump(2U);
-    ofs.close();
+nlohmann::basic_json<> readJSON(const std::string& filename) {
+  std::ifstream ifs(filename);
+  if (!ifs.good()) {
+    return nlohmann::basic_json<>::object();
   }
+  return nlohmann::json::parse(ifs);
+}
+} // namespace
 
+class BenchmarkDDPackage {
   std::string inputFilename;
 
-  void runGHZ() const {
-    constexpr std::array nqubits = {256U, 512U, 1024U, 2048U, 4096U};
-    std::cout << "Running GHZ Simulation..." << '\n';
-    for (const auto& nq : nqubits) {
-      auto qc = qc::Entanglement(nq);
-      auto exp = benchmarkSimulate(qc);
-      verifyAndSave("GHZ", "Simulation", qc, *exp);
-    }
-    std::cout << "Running GHZ Functionality..." << '\n';
-    for (const auto& nq : nqubits) {
-      auto qc = qc::Entanglement(nq);
-      auto exp = benchmarkFunctionalityConstruction(qc);
-      verifyAndSave("GHZ", "Functionality", qc, *exp);
-    }
+  [[nodiscard]] std::string resultsFilename() const {
+    return "results_" + inputFilename + ".json";
   }
 
-  void runWState() const {
-    constexpr std::array nqubits = {256U, 512U, 1024U, 2048U, 4096U};
-    std::cout << "Running WState Simulation..." << '\n';
-    for (const auto& nq : nqubits) {
-      auto qc = qc::WState(nq);
-      auto exp = benchmarkSimulate(qc);
-      verifyAndSave("WState", "Simulation", qc, *exp);
-    }
-    std::cout << "Running WState Functionality..." << '\n';
-    for (const auto& nq : nqubits) {
-      auto qc = qc::WState(nq);
-      auto exp = benchmarkFunctionalityConstruction(qc);
-      verifyAndSave("WState", "Functionality", qc, *exp);
-    }
+  static nlohmann::basic_json<> metadata(const BenchmarkSuite& suite) {
+    nlohmann::basic_json<> j;
+    j["format_version"] = RESULTS_FORMAT_VERSION;
+    j["suite"] = suite.name;
+    j["warmup"] = suite.warmup;
+    j["repetitions"] = suite.repetitions;
+    j["seed"] = SEED;
+#ifdef __VERSION__
+    j["compiler"] = __VERSION__;
+#endif
+#ifdef NDEBUG
+    j["assertions"] = false;
+#else
+    j["assertions"] = true;
+#endif
+    return j;
   }
 
-  void runBV() const {
-    constexpr std::array nqubits = {255U, 511U, 1023U, 2047U, 4095U};
-    std::cout << "Running BV Simulation..." << '\n';
-    for (const auto& nq : nqubits) {
-      auto qc = qc::BernsteinVazirani(nq);
-      qc::CircuitOptimizer::removeFinalMeasurements(qc);
-      auto exp = benchmarkSimulate(qc);
-      verifyAndSave("BV", "Simulation", qc, *exp);
+  static nlohmann::basic_json<> measure(const BenchmarkSuite& suite,
+                                        const BenchmarkSpec& spec,
+                                        const QuantumComputation& qc) {
+    for (std::size_t i = 0U; i < suite.warmup; ++i) {
+      static_cast<void>(runOnce(spec, qc));
     }
-    std::cout << "Running BV Functionality..." << '\n';
-    for (const auto& nq : nqubits) {
-      auto qc = qc::BernsteinVazirani(nq);
-      qc::CircuitOptimizer::removeFinalMeasurements(qc);
-      auto exp = benchmarkFunctionalityConstruction(qc);
-      verifyAndSave("BV", "Functionality", qc, *exp);
+    std::vector<double> runtimes{};
+    Measurement last{};
+    for (std::size_t i = 0U; i < suite.repetitions; ++i) {
+      last = runOnce(spec, qc);
+      runtimes.emplace_back(last.runtime);
     }
+    std::sort(runtimes.begin(), runtimes.end());
+
+    nlohmann::basic_json<> entry;
+    entry["runtime"] = percentile(runtimes, 0.5);
+    entry["runtime_min"] = runtimes.front();
+    entry["runtime_p90"] = percentile(runtimes, 0.9);
+    entry["runtime_max"] = runtimes.back();
+    entry["repetitions"] = runtimes.size();
+    // the DD package is deterministic, so the statistics of any run will do
+    entry["peak_memory_mib"] = last.peakMemoryMiB;
+    entry["dd"] = last.stats;
+    return entry;
   }
 
-  void runQFT() const {
-    constexpr std::array nqubitsSim = {256U, 512U, 1024U, 2048U, 4096U};
-    std::cout << "Running QFT Simulation..." << '\n';
-    for (const auto& nq : nqubitsSim) {
-      auto qc = qc::QFT(nq, false);
-      auto exp = benchmarkSimulate(qc);
-      verifyAndSave("QFT", "Simulation", qc, *exp);
-    }
-    constexpr std::array nqubitsFunc = {18U, 19U, 20U, 21U, 22U};
-    std::cout << "Running QFT Functionality..." << '\n';
-    for (const auto& nq : nqubitsFunc) {
-      auto qc = qc::QFT(nq, false);
-      auto exp = benchmarkFunctionalityConstruction(qc);
-      verifyAndSave("QFT", "Functionality", qc, *exp);
-    }
-  }
+public:
+  explicit BenchmarkDDPackage(std::string filename)
+      : inputFilename(std::move(filename)) {};
 
-  void runGrover() {
-    constexpr std::array nqubits = {27U, 31U, 35U, 39U, 41U};
-    std::cout << "Running Grover Simulation..." << '\n';
-    for (const auto& nq : nqubits) {
-      auto qc = std::make_unique<qc::Grover>(nq, SEED);
-      auto dd = std::make_unique<dd::Package<>>(qc->getNqubits());
-      const auto start = std::chrono::high_resolution_clock::now();
-
-      // apply state preparation setup
-      qc::QuantumComputation statePrep(qc->getNqubits());
-      qc->setup(statePrep);
-      auto s = buildFunctionality(&statePrep, *dd);
-      auto e = dd->applyOperation(s, dd->makeZeroState(qc->getNqubits()));
-
-      qc::QuantumComputation groverIteration(qc->getNqubits());
-      qc->oracle(groverIteration);
-      qc->diffusion(groverIteration);
-
-      auto iter = buildFunctionalityRecursive(&groverIteration, *dd);
-      std::bitset<128U> iterBits(qc->iterations);
-      const auto msb =
-          static_cast<std::size_t>(std::floor(std::log2(qc->iterations)));
-      auto f = iter;
-      dd->incRef(f);
-      for (std::size_t j = 0U; j <= msb; ++j) {
-        if (iterBits[j]) {
-          e = dd->applyOperation(f, e);
-        }
-        if (j < msb) {
-          f = dd->applyOperation(f, f);
-        }
+  /**
+   * @brief Run all benchmarks of the suite and merge them into the results
+   * file
+   * @return Only the entries produced by this run
+   */
+  nlohmann::basic_json<> run(const BenchmarkSuite& suite) const {
+    const auto filename = resultsFilename();
+    auto j = readJSON(filename);
+    j["metadata"] = metadata(suite);
+    auto produced = nlohmann::basic_json<>::object();
+    for (const auto& spec : suite.benchmarks) {
+      std::cout << "Running " << spec.algorithm << " " << spec.task << " ("
+                << spec.config << ")..." << '\n';
+      const auto task =
+          spec.config == "default" ? spec.task : spec.task + "_" + spec.config;
+      for (const auto& nq : spec.qubits) {
+        const auto qc = makeCircuit(spec.algorithm, nq);
+        auto entry = measure(suite, spec, *qc);
+        produced[spec.algorithm][task][std::to_string(nq)] = entry;
+        j[spec.algorithm][task][std::to_string(nq)] = std::move(entry);
+        // results are written after every benchmark to survive interruptions
+        std::ofstream ofs(filename);
+        ofs << j.dump(2U);
       }
-      dd->decRef(f);
-      const auto end = std::chrono::high_resolution_clock::now();
-      const auto runtime =
-          std::chrono::duration_cast<std::chrono::duration<double>>(end -
-                                                                    start);
-      auto exp = std::make_unique<SimulationExperiment>();
-      exp->dd = std::move(dd);
-      exp->sim = e;
-      exp->runtime = runtime;
-      exp->stats = dd::getStatistics(exp->dd.get());
-
-      verifyAndSave("Grover", "Simulation", *qc, *exp);
-    }
-
-    std::cout << "Running Grover Functionality..." << '\n';
-    for (const auto& nq : nqubits) {
-
-      auto qc = std::make_unique<qc::Grover>(nq, SEED);
-      auto exp = benchmarkFunctionalityConstruction(*qc, true);
-      verifyAndSave("Grover", "Functionality", *qc, *exp);
     }
+    return produced;
   }
 
-  void runQPE() const {
-    constexpr std::array nqubitsSim = {14U, 15U, 16U, 17U, 18U};
-    std::cout << "Running QPE Simulation..." << '\n';
-    for (const auto& nq : nqubitsSim) {
-      auto qc = qc::QPE(nq, false);
-      qc::CircuitOptimizer::removeFinalMeasurements(qc);
-      auto exp = benchmarkSimulate(qc);
-      verifyAndSave("QPE", "Simulation", qc, *exp);
+  /**
+   * @brief Compare results against a baseline
+   * @details A benchmark regresses if its median runtime or its peak memory
+   * exceeds the baseline by more than the given relative threshold.
+   * Benchmarks missing from the baseline are ignored.
+   * @param results The entries produced by a call to run()
+   * @param baselineFilename The results file to compare against
+   * @param threshold The tolerated relative increase
+   * @return The number of regressions
+   */
+  [[nodiscard]] static std::size_t
+  compare(const nlohmann::basic_json<>& results,
+          const std::string& baselineFilename, const double threshold) {
+    const auto baseline = readJSON(baselineFilename);
+    if (baseline.empty()) {
+      throw std::invalid_argument("Cannot read baseline: " + baselineFilename);
     }
-    std::cout << "Running QPE Functionality..." << '\n';
-    constexpr std::array nqubitsFunc = {7U, 8U, 9U, 10U, 11U};
-    for (const auto& nq : nqubitsFunc) {
-      auto qc = qc::QPE(nq, false);
-      qc::CircuitOptimizer::removeFinalMeasurements(qc);
-      auto exp = benchmarkFunctionalityConstruction(qc);
-      verifyAndSave("QPE", "Functionality", qc, *exp);
+    if (baseline.contains("metadata") &&
+        baseline["metadata"].value("format_version", 0U) !=
+            RESULTS_FORMAT_VERSION) {
+      throw std::runtime_error("Baseline has an incompatible format version.");
     }
-  }
 
-  void runRandomClifford() const {
-    constexpr std::array<std::size_t, 5> nqubitsSim = {14U, 15U, 16U, 17U, 18U};
-    std::cout << "Running RandomClifford Simulation..." << '\n';
-    for (const auto& nq : nqubitsSim) {
-      auto qc = qc::RandomCliffordCircuit(nq, nq * nq, SEED);
-      auto exp = benchmarkSimulate(qc);
-      verifyAndSave("RandomClifford", "Simulation", qc, *exp);
-    }
-    std::cout << "Running RandomClifford Functionality..." << '\n';
-    constexpr std::array<std::size_t, 5> nqubitsFunc = {7U, 8U, 9U, 10U, 11U};
-    for (const auto& nq : nqubitsFunc) {
-      auto qc = qc::RandomCliffordCircuit(nq, nq * nq, SEED);
-      auto exp = benchmarkFunctionalityConstruction(qc);
-      verifyAndSave("RandomClifford", "Functionality", qc, *exp);
+    std::size_t regressions = 0U;
+    for (const auto& [algorithm, tasks] : results.items()) {
+      if (!baseline.contains(algorithm)) {
+        continue;
+      }
+      for (const auto& [task, sizes] : tasks.items()) {
+        if (!baseline[algorithm].contains(task)) {
+          continue;
+        }
+        for (const auto& [nq, entry] : sizes.items()) {
+          if (!baseline[algorithm][task].contains(nq)) {
+            continue;
+          }
+          const auto& reference = baseline[algorithm][task][nq];
+          for (const auto* metric : {"runtime", "peak_memory_mib"}) {
+            if (!entry.contains(metric) || !reference.contains(metric)) {
+              continue;
+            }
+            const auto before = reference[metric].get<double>();
+            const auto after = entry[metric].get<double>();
+            if (after > before * (1. + threshold)) {
+              ++regressions;
+              std::cout << "Regression in " << algorithm << "." << task << "."
+                        << nq << "." << metric << ": " << before << " -> "
+                        << after << '\n';
+            }
+          }
+        }
+      }
     }
-  }
-
-public:
-  explicit BenchmarkDDPackage(std::string filename)
-      : inputFilename(std::move(filename)) {};
-
-  void runAll() {
-    runGHZ();
-    runWState();
-    runBV();
-    runQFT();
-    runGrover();
-    runQPE();
-    runRandomClifford();
+    return regressions;
   }
 };
 
 } // namespace dd
 
+namespace {
+void printUsage() {
+  std::cerr << "Usage: mqt-core-dd-eval <name> [--suite <suite.json>] "
+               "[--baseline <results.json>] [--threshold <ratio>]\n"
+            << "Runs the benchmark suite (the default suite if none is given), "
+               "writes the results to results_<name>.json, and optionally "
+               "fails if any benchmark regressed compared to the baseline.\n";
+}
+} // namespace
+
 int main(const int argc, char** argv) {
-  if (argc != 2) {
-    std::cerr << "Exactly one argument is required to name the results file."
-              << '\n';
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  if (args.empty() || args.front().rfind("--", 0) == 0) {
+    printUsage();
     return 1;
   }
+  std::string suiteFilename;
+  std::string baselineFilename;
+  double threshold = 0.1;
+  for (std::size_t i = 1U; i < args.size(); ++i) {
+    if (i + 1U == args.size()) {
+      printUsage();
+      return 1;
+    }
+    if (args[i] == "--suite") {
+      suiteFilename = args[++i];
+    } else if (args[i] == "--baseline") {
+      baselineFilename = args[++i];
+    } else if (args[i] == "--threshold") {
+      try {
+        std::size_t parsed = 0U;
+        const auto& value = args[++i];
+        threshold = std::stod(value, &parsed);
+        if (parsed != value.size() || !(threshold >= 0.)) {
+          throw std::invalid_argument(value);
+        }
+      } catch (const std::logic_error&) {
+        std::cerr << "Invalid threshold: " << args[i] << '\n';
+        printUsage();
+        return 1;
+      }
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
   try {
-    auto run = dd::BenchmarkDDPackage(
-        argv[1]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    run.runAll();
+    const auto suite = suiteFilename.empty()
+                           ? dd::BenchmarkSuite::defaultSuite()
+                           : dd::BenchmarkSuite::fromFile(suiteFilename);
+    const auto run = dd::BenchmarkDDPackage(args.front());
+    const auto results = run.run(suite);
+    std::cout << "Benchmarks done." << '\n';
+    if (!baselineFilename.empty()) {
+      const auto regressions =
+          dd::BenchmarkDDPackage::compare(results, baselineFilename, threshold);
+      if (regressions > 0U) {
+        std::cout << regressions << " regression(s) detected." << '\n';
+        return 2;
+      }
+      std::cout << "No regressions detected." << '\n';
+    }
   } catch (const std::exception& e) {
     std::cerr << "Exception caught: " << e.what() << '\n';
     return 1;
   }
-  std::cout << "Benchmarks done." << '\n';
   return 0;
 }
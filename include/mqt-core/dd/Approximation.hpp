@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package_fwd.hpp"
+
+#include <cstddef>
+
+namespace dd {
+
+/**
+ * @brief Strategy for bounding the size of state vector DDs during simulation
+ * @details Whenever the DD representing the current state exceeds @p maxNodes
+ * nodes, the nodes contributing the least to the norm of the state are removed
+ * until the DD has at most `targetRatio * maxNodes` nodes.
+ */
+struct NodeBudgetApproximation {
+  /// The maximum number of nodes of the state DD (0 disables approximation)
+  std::size_t maxNodes = 0U;
+  /// The fraction of @p maxNodes the DD is reduced to once the budget is hit
+  fp targetRatio = 1.;
+
+  [[nodiscard]] bool enabled() const noexcept { return maxNodes != 0U; }
+};
+
+/**
+ * @brief Information collected over the approximation rounds of a simulation
+ */
+struct ApproximationMetadata {
+  /// Product of the fidelities of all approximation rounds
+  fp fidelity = 1.;
+  /// Number of approximation rounds
+  std::size_t rounds = 0U;
+  /// Total number of nodes removed over all rounds
+  std::size_t removedNodes = 0U;
+};
+
+/**
+ * @brief Approximate a state vector DD by removing low-contribution nodes
+ * @details The contribution of a node is the squared norm of the part of the
+ * state that is represented by paths through the node. All contributions are
+ * computed in a single top-down traversal. Nodes are removed in order of
+ * increasing contribution (ties are broken by level and by the order in which
+ * the traversal reaches the nodes) until the DD has at most @p maxNodes nodes.
+ * The nodes on the path from the root that always follows the successor with
+ * the larger weight are never removed, so that the approximated state is not
+ * the zero vector. Afterwards, the state is renormalized. The reference count
+ * of @p state is transferred to the approximated state and garbage collection
+ * is triggered.
+ * @param state The state to approximate. Replaced by the approximated state.
+ * @param maxNodes The maximum number of nodes of the approximated state
+ * @param dd The DD package
+ * @param metadata Statistics that are updated with this approximation round
+ * @return The fidelity between the original and the approximated state
+ */
+template <class Config>
+fp approximate(vEdge& state, std::size_t maxNodes, Package<Config>& dd,
+               ApproximationMetadata& metadata);
+
+} // namespace dd
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/Node.hpp"
+#include "dd/Package_fwd.hpp"
+#include "ir/Permutation.hpp"
+#include "ir/QuantumComputation.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dd {
+
+/// Version of the simulation checkpoint format
+static constexpr std::uint32_t CHECKPOINT_VERSION = 2U;
+
+/// Magic bytes at the beginning of every simulation checkpoint
+static constexpr std::array<char, 8> CHECKPOINT_MAGIC = {'M', 'Q', 'T', 'D',
+                                                         'D', 'C', 'K', 'P'};
+
+/**
+ * @brief Configuration of periodic checkpointing during simulation
+ */
+struct CheckpointOptions {
+  /// The file checkpoints are written to (and resumed from)
+  std::string filename;
+  /// Number of operations between two checkpoints (0 disables checkpointing)
+  std::size_t interval = 0U;
+  /// Whether to continue from the checkpoint in @p filename if it exists
+  bool resume = false;
+  /// Whether to use the compressed variant of the compact DD serialization
+  bool compress = true;
+
+  [[nodiscard]] bool enabled() const noexcept {
+    return interval != 0U && !filename.empty();
+  }
+};
+
+/**
+ * @brief Snapshot of a running simulation
+ */
+struct SimulationCheckpoint {
+  /// The current state
+  vEdge state{};
+  /// The current qubit permutation (as modified by virtual SWAP gates)
+  qc::Permutation permutation{};
+  /// Index of the next operation to simulate
+  std::size_t nextOperation = 0U;
+  /// Total number of operations of the simulated circuit
+  std::size_t numOperations = 0U;
+  /// Fingerprint of the simulated circuit (see circuitFingerprint())
+  std::uint64_t fingerprint = 0U;
+  /// Textual state of the random number generator (empty if unused)
+  std::string rngState{};
+};
+
+/**
+ * @brief Compute a fingerprint identifying a circuit in a checkpoint
+ * @details The fingerprint covers the number of qubits, the initial layout,
+ * the output permutation, and the type, targets, controls, and parameters of
+ * each operation (including the operations nested in compound and classically
+ * controlled operations). It is used to detect whether a checkpoint belongs to
+ * the circuit to be simulated and is no cryptographic hash.
+ * @param qc The circuit
+ * @return The fingerprint
+ */
+[[nodiscard]] std::uint64_t
+circuitFingerprint(const qc::QuantumComputation& qc);
+
+/**
+ * @brief Write a simulation checkpoint to a file
+ * @details The checkpoint is first written to a temporary file next to
+ * @p filename, which is synced to disk and then atomically replaces
+ * @p filename. Hence, neither an interrupted write nor a crash of the system
+ * destroys the previous checkpoint. The state is
+ * stored in the compact DD serialization format (see serializeCompact()).
+ * @param filename The file to write to
+ * @param checkpoint The checkpoint to write
+ * @param compress Whether to use the compressed node table encoding
+ */
+void saveCheckpoint(const std::string& filename,
+                    const SimulationCheckpoint& checkpoint,
+                    bool compress = true);
+
+/**
+ * @brief Read a simulation checkpoint from a file
+ * @param filename The file to read from
+ * @param dd The DD package to load the state into
+ * @return The checkpoint. The reference count of its state is increased.
+ * @throws std::runtime_error if the file is not a valid checkpoint
+ */
+template <class Config>
+SimulationCheckpoint loadCheckpoint(const std::string& filename,
+                                    Package<Config>& dd);
+
+} // namespace dd
@@ -37,11 +37,17 @@ struct DDPackageConfig {
   static constexpr std::size_t UT_DM_INITIAL_ALLOCATION_SIZE = 1U;
   static constexpr std::size_t CT_DM_DM_MULT_NBUCKET = 1U;
   static constexpr std::size_t CT_DM_ADD_NBUCKET = 1U;
+  static constexpr std::size_t CT_OPERATION_NBUCKET = 1024U;
+  static constexpr std::size_t CT_VEC_GATE_NBUCKET = 4096U;
 
   // The number of different quantum operations. I.e., the number of operations
   // defined in OpType.hpp. This parameter is required to initialize the
   // StochasticNoiseOperationTable.hpp
   static constexpr std::size_t STOCHASTIC_CACHE_OPS = 1;
+
+  // Whether real numbers that are (up to rounding errors) elements of Q(√2)
+  // are represented exactly. See RealNumberUniqueTable::setExactLookups.
+  static constexpr bool EXACT_WEIGHTS = false;
 };
 
 struct StochasticNoiseSimulatorDDPackageConfig : public dd::DDPackageConfig {
@@ -75,6 +81,7 @@ struct DensityMatrixSimulatorDDPackageConfig : public dd::DDPackageConfig {
   static constexpr std::size_t CT_DM_TRACE_NBUCKET = 4096U;
   static constexpr std::size_t CT_MAT_TRACE_NBUCKET = 1U;
   static constexpr std::size_t CT_VEC_INNER_PROD_NBUCKET = 1U;
+  static constexpr std::size_t CT_VEC_GATE_NBUCKET = 1U;
   static constexpr std::size_t STOCHASTIC_CACHE_OPS = 1U;
   static constexpr std::size_t CT_VEC_ADD_MAG_NBUCKET = 1U;
   static constexpr std::size_t CT_MAT_ADD_MAG_NBUCKET = 1U;
@@ -103,4 +110,9 @@ struct UnitarySimulatorDDPackageConfig : public dd::DDPackageConfig {
   static constexpr std::size_t CT_MAT_TRACE_NBUCKET = 1U;
   static constexpr std::size_t CT_VEC_INNER_PROD_NBUCKET = 1U;
 };
+
+struct CliffordTDDPackageConfig : public dd::DDPackageConfig {
+  // all weights of Clifford+T circuits are elements of Q(√2, i)
+  static constexpr bool EXACT_WEIGHTS = true;
+};
 } // namespace dd
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/Node.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace dd {
+
+/**
+ * @brief Compute the Schmidt coefficients of a state across a cut
+ * @details The cut separates the qubits `0, ..., cut - 1` from the qubits
+ * `cut, ..., n - 1`. Writing the state as |ψ> = Σ_j |a_j>|φ_j>, where the
+ * |φ_j> are the sub-DDs rooted directly below the cut and the |a_j> collect
+ * the paths from the root to them, the squared Schmidt coefficients are the
+ * eigenvalues of C·G with the Gram matrices C_jk = <a_k|a_j> and
+ * G_jk = <φ_j|φ_k>. Both are computed from the DD, so the cost depends on the
+ * number r of nodes directly below the cut (O(r^3)) instead of the dimension
+ * of the reduced density matrix.
+ * @param state The state DD
+ * @param cut The number of qubits below the cut
+ * @return The non-zero Schmidt coefficients in descending order, normalized
+ * such that their squares sum up to one
+ * @throws std::invalid_argument if @p cut exceeds the number of qubits
+ */
+[[nodiscard]] std::vector<fp> schmidtCoefficients(const vEdge& state,
+                                                  std::size_t cut);
+
+/**
+ * @brief Compute the entanglement entropy of a state across a cut
+ * @details The von Neumann entropy (in bits) of the reduced density matrix of
+ * either side of the cut, obtained from schmidtCoefficients().
+ * @param state The state DD
+ * @param cut The number of qubits below the cut
+ * @return The entanglement entropy
+ * @throws std::invalid_argument if @p cut exceeds the number of qubits
+ */
+[[nodiscard]] fp entanglementEntropy(const vEdge& state, std::size_t cut);
+
+/**
+ * @brief Compute the entanglement entropy across all cuts of a state
+ * @details The Gram matrices of all cuts are computed in one top-down and one
+ * bottom-up pass over the DD, where the matrices of each level are derived
+ * from those of the adjacent level.
+ * @param state The state DD on n qubits
+ * @return The n + 1 entropies, where the entry at index `cut` corresponds to
+ * entanglementEntropy(state, cut)
+ */
+[[nodiscard]] std::vector<fp> entanglementProfile(const vEdge& state);
+
+} // namespace dd
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/Package_fwd.hpp"
+#include "ir/QuantumComputation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dd {
+
+/// The outcome of an equivalence check
+enum class EquivalenceCriterion : std::uint8_t {
+  /// the circuits realize different functionalities
+  NotEquivalent,
+  /// the circuits realize the same functionality
+  Equivalent,
+  /// the functionalities only differ by a global phase
+  EquivalentUpToGlobalPhase,
+  /// the check was aborted before a decision could be made
+  NoInformation
+};
+
+/// The order in which the gates of both circuits are applied
+enum class AlternatingScheme : std::uint8_t {
+  /// alternate between one gate of each circuit
+  OneToOne,
+  /// apply the gates of both circuits in proportion to their gate counts
+  Proportional,
+  /// apply the gate (of either circuit) that yields the smaller DD
+  Lookahead
+};
+
+/**
+ * @brief Settings for checkEquivalence()
+ */
+struct EquivalenceCheckingConfiguration {
+  /// The order in which the gates are applied
+  AlternatingScheme scheme = AlternatingScheme::Proportional;
+  /// The tolerance used when comparing the result to the identity
+  fp tolerance = 1e-10;
+  /// Abort the check once the intermediate DD exceeds this number of nodes
+  /// (0 disables the limit)
+  std::size_t maxNodes = 0U;
+};
+
+/**
+ * @brief The result of checkEquivalence()
+ */
+struct EquivalenceCheckingResult {
+  EquivalenceCriterion equivalence = EquivalenceCriterion::NoInformation;
+  /// The largest size of the intermediate DD
+  std::size_t peakNodes = 0U;
+  /// The number of gates that have been applied from the first circuit
+  std::size_t appliedLeft = 0U;
+  /// The number of gates that have been applied from the second circuit
+  std::size_t appliedRight = 0U;
+};
+
+/**
+ * @brief Check two circuits for equivalence with the alternating scheme
+ * @details Instead of constructing both functionalities U and U', the DD of
+ * U·U'^† is built directly. Starting from the identity, the gates of @p qc1
+ * are applied from the left and the inverted gates of @p qc2 are applied from
+ * the right in an order determined by `config.scheme`. For (almost)
+ * equivalent circuits, the intermediate DD then stays close to the identity,
+ * which is significantly smaller than the DD of either functionality.
+ * Uncontrolled SWAP gates are executed virtually by changing the respective
+ * permutation and barriers are ignored. Ancillary and garbage qubits are
+ * taken from the circuits, where the garbage qubits of both circuits are
+ * ignored in the final comparison.
+ *
+ * If the intermediate DD grows beyond `config.maxNodes`, the check stops and
+ * reports EquivalenceCriterion::NoInformation instead of exhausting the
+ * available memory. The final comparison with the identity stops at the first
+ * node that deviates from it.
+ * @param qc1 The first circuit
+ * @param qc2 The second circuit
+ * @param dd The DD package (with at least as many qubits as the circuits)
+ * @param config The settings of the check
+ * @return The outcome of the check together with some statistics
+ * @throws std::invalid_argument if the circuits act on different numbers of
+ * qubits or contain non-unitary operations (e.g., measurements, which have to
+ * be removed beforehand)
+ */
+template <class Config>
+EquivalenceCheckingResult
+checkEquivalence(const qc::QuantumComputation& qc1,
+                 const qc::QuantumComputation& qc2, Package<Config>& dd,
+                 const EquivalenceCheckingConfiguration& config = {});
+
+/// The kind of input states used to falsify equivalence
+enum class StimuliType : std::uint8_t {
+  /// random computational basis states
+  Classical,
+  /// random tensor products of the six single-qubit stabilizer states
+  LocalQuantum
+};
+
+/**
+ * @brief Settings for falsifyEquivalence()
+ */
+struct FalsificationConfiguration {
+  /// The number of random input states
+  std::size_t stimuli = 16U;
+  /// The kind of input states
+  StimuliType type = StimuliType::LocalQuantum;
+  /// The number of threads (0 uses the hardware concurrency)
+  std::size_t nthreads = 0U;
+  /// The seed for generating the input states (0 uses a random seed)
+  std::size_t seed = 0U;
+  /// Output states with a smaller fidelity are considered different
+  fp fidelityThreshold = 1. - 1e-8;
+};
+
+/**
+ * @brief The result of falsifyEquivalence()
+ */
+struct FalsificationResult {
+  /// Whether an input state has been found for which the outputs differ
+  bool falsified = false;
+  /// The distinguishing input state (one entry per qubit), if any
+  std::vector<BasisStates> counterexample;
+  /// The fidelity between both output states for the counterexample
+  fp fidelity = 1.;
+  /// The number of input states that have been simulated
+  std::size_t simulations = 0U;
+  /// The number of vector nodes still referenced in the DD packages of the
+  /// threads after their last simulation (zero unless references leak)
+  std::size_t activeNodes = 0U;
+};
+
+/**
+ * @brief Search for an input state that distinguishes two circuits
+ * @details Both circuits are simulated on a batch of random input states and
+ * the fidelity of the resulting states is compared. If it falls below
+ * `config.fidelityThreshold`, the circuits are certainly not equivalent and
+ * the input state is reported as a counterexample. Otherwise, nothing can be
+ * concluded, but in practice, most errors are caught by only a few stimuli.
+ * Since global phases do not affect the fidelity, circuits that are
+ * equivalent up to a global phase are never falsified. Ancillary qubits (of
+ * either circuit) are always initialized to |0>.
+ *
+ * The stimuli are distributed among `config.nthreads` threads, each of which
+ * uses its own DD package. Once a counterexample has been found, the threads
+ * skip all later stimuli of the batch. Since the batch is generated upfront
+ * from `config.seed`, the reported counterexample is the first distinguishing
+ * stimulus of the batch, independent of the number of threads.
+ * @param qc1 The first circuit
+ * @param qc2 The second circuit
+ * @param config The settings of the search
+ * @return Whether the circuits have been shown to be different, together with
+ * a counterexample
+ * @throws std::invalid_argument if the circuits act on different numbers of
+ * qubits or contain non-unitary operations
+ */
+template <class Config = DDPackageConfig>
+FalsificationResult
+falsifyEquivalence(const qc::QuantumComputation& qc1,
+                   const qc::QuantumComputation& qc2,
+                   const FalsificationConfiguration& config = {});
+
+} // namespace dd
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <unordered_map>
+
+namespace dd {
+
+struct RealNumber;
+
+/**
+ * @brief An element of the field Q(√2), i.e., a number (a + b√2) / n
+ * @details All amplitudes of Clifford+T circuits are elements of Z[1/√2, i].
+ * Since DD edge weights are normalized by dividing by one of them, the real and
+ * imaginary parts of all weights (and, hence, all real numbers stored in the
+ * DD package) are elements of Q(√2). The representation is kept in its
+ * canonical form, i.e., n is positive and gcd(a, b, n) = 1.
+ */
+struct RationalSqrt2 {
+  /// The integer part of the numerator
+  std::int64_t a = 0;
+  /// The coefficient of √2 in the numerator
+  std::int64_t b = 0;
+  /// The denominator
+  std::int64_t n = 1;
+
+  /// The maximal absolute value of a, b, and n considered during recognition
+  static constexpr std::int64_t MAX_COEFFICIENT = 1024;
+  /**
+   * @brief The maximal deviation of a recognized number from its exact value
+   * in multiples of the tolerance of the real number table (RealNumber::eps)
+   * @details Numbers stored in the real number table may deviate from their
+   * exact value by up to the tolerance of the table, plus the rounding errors
+   * of the computation that produced them. Any larger tolerance only makes it
+   * more likely that a number which is not contained in Q(√2) is recognized by
+   * accident.
+   */
+  static constexpr fp RECOGNITION_TOLERANCE_FACTOR = 2.;
+
+  /// Make the denominator positive and divide out common factors
+  void canonicalize() noexcept;
+
+  /// The floating point number closest to the exact value
+  [[nodiscard]] fp value() const noexcept;
+
+  /**
+   * @brief Recognize a floating point number as an element of Q(√2)
+   * @details Searches for an integer relation n * val - a - b√2 ≈ 0 with
+   * small coefficients by lattice reduction (LLL) of a three-dimensional
+   * lattice. The number is recognized if the relation holds up to
+   * RECOGNITION_TOLERANCE_FACTOR * RealNumber::eps and all coefficients are
+   * bounded by MAX_COEFFICIENT.
+   * @param val The number to recognize
+   * @returns The canonical representation or std::nullopt if there is no
+   * such relation.
+   */
+  [[nodiscard]] static std::optional<RationalSqrt2> recognize(fp val) noexcept;
+
+  [[nodiscard]] bool operator==(const RationalSqrt2& other) const noexcept {
+    return a == other.a && b == other.b && n == other.n;
+  }
+  [[nodiscard]] bool operator!=(const RationalSqrt2& other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+std::ostream& operator<<(std::ostream& os, const RationalSqrt2& x);
+
+/**
+ * @brief A unique table mapping exact numbers to entries of the real number
+ * table
+ * @details Used by the RealNumberUniqueTable if exact weights are enabled
+ * (see DDPackageConfig::EXACT_WEIGHTS). Entries are keyed by their exact
+ * representation so that numbers that are mathematically equal are always
+ * mapped to the same entry, no matter how far they drifted apart during the
+ * floating point computations that produced them.
+ */
+class ExactRealNumberTable {
+public:
+  /**
+   * @brief Find the entry for an exact number
+   * @returns The entry or nullptr if the number is not contained in the table
+   */
+  [[nodiscard]] RealNumber* find(const RationalSqrt2& x) const;
+
+  /// Register the entry for an exact number
+  void insert(const RationalSqrt2& x, RealNumber* entry);
+
+  /**
+   * @brief Remove all entries with a reference count of zero
+   * @details Has to be called before the real number table returns these
+   * entries to its memory manager.
+   * @returns The number of removed entries
+   */
+  std::size_t garbageCollect() noexcept;
+
+  /// Remove all entries
+  void clear() noexcept { table.clear(); }
+
+  [[nodiscard]] std::size_t size() const noexcept { return table.size(); }
+
+private:
+  struct Hash {
+    std::size_t operator()(const RationalSqrt2& x) const noexcept;
+  };
+
+  std::unordered_map<RationalSqrt2, RealNumber*, Hash> table;
+};
+
+} // namespace dd
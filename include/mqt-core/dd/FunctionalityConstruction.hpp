@@ -11,6 +11,7 @@
 
 #include "dd/Operations.hpp"
 #include "dd/Package_fwd.hpp"
+#include "dd/Reordering.hpp"
 #include "ir/Permutation.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/OpType.hpp"
@@ -27,6 +28,28 @@ using namespace qc;
 template <class Config>
 MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd);
 
+/**
+ * @brief Build the functionality of a quantum computation with qubit
+ * reordering
+ * @details Works like the regular construction, but starts from the order
+ * proposed by proposeQubitOrder() if `strategy.staticOrder` is set, and
+ * whenever the DD exceeds the current threshold of @p strategy (checked every
+ * `strategy.checkInterval` operations), its qubit order is improved (see
+ * reorder()). Since reordering exchanges the levels of
+ * inputs and outputs alike, the levels of the inputs are tracked separately
+ * and restored to the initial layout at the end (in addition to restoring the
+ * outputs to the output permutation).
+ * @param qc The quantum computation
+ * @param dd The DD package
+ * @param strategy The reordering strategy
+ * @param metadata Collects statistics of the reordering rounds
+ * @return The functionality of the quantum computation
+ */
+template <class Config>
+MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd,
+                            const DynamicReordering& strategy,
+                            ReorderingMetadata& metadata);
+
 template <class Config>
 MatrixDD buildFunctionalityRecursive(const QuantumComputation* qc,
                                      Package<Config>& dd);
@@ -37,6 +60,25 @@ bool buildFunctionalityRecursive(const QuantumComputation* qc,
                                  std::stack<MatrixDD>& s,
                                  Permutation& permutation, Package<Config>& dd);
 
+/**
+ * @brief Build the functionality of a quantum computation in parallel
+ * @details The circuit is split into contiguous sub-ranges of operations that
+ * are built concurrently, each in a separate DD package. The partial unitaries
+ * are then combined in a balanced tree of multiplications, where all products
+ * on the same level of the tree are computed concurrently. Partial results are
+ * moved between packages via Package::transfer. The final result is
+ * transferred to @p dd.
+ * @param qc The quantum computation
+ * @param dd The DD package the result is constructed in
+ * @param nthreads The number of threads to use (0 uses the hardware
+ * concurrency)
+ * @return The functionality of the quantum computation
+ */
+template <class Config>
+MatrixDD buildFunctionalityParallel(const QuantumComputation* qc,
+                                    Package<Config>& dd,
+                                    std::size_t nthreads = 0U);
+
 inline void dumpTensorNetwork(std::ostream& of, const QuantumComputation& qc) {
   of << "{\"tensors\": [\n";
 
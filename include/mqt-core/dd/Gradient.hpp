@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package_fwd.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Expression.hpp"
+
+#include <unordered_map>
+
+namespace dd {
+
+/**
+ * @brief The result of computeGradient()
+ */
+struct GradientResult {
+  /// The expectation value <ψ|H|ψ> of the final state
+  fp expectationValue = 0.;
+  /// The derivative of the expectation value with respect to each variable
+  std::unordered_map<sym::Variable, fp> gradient;
+};
+
+/**
+ * @brief Compute the gradient of an expectation value of a parametrized
+ * circuit
+ * @details The circuit is simulated once to obtain the final state |ψ> and the
+ * expectation value. Then, |ψ> and the adjoint state H|ψ> are propagated
+ * backwards through the circuit by applying the inverse operations, such that
+ * before each operation U_k both the input state of U_k and the adjoint state
+ * after U_k are available. The derivative with respect to a parameter θ of
+ * U_k follows from the parameter-shift rule applied to the gate itself:
+ * dU_k/dθ = c·(U_k(θ + s) - U_k(θ - s)), where s and c depend on whether the
+ * gate matrix depends on θ/2 (rotations, s = π, c = 1/4) or on θ (phases,
+ * s = π/2, c = 1/2). Hence, all derivatives are obtained from about three
+ * simulations instead of two simulations per parameter. The derivatives of
+ * the gate parameters are combined into the derivatives of the variables by
+ * the chain rule.
+ *
+ * Uncontrolled SWAP gates are executed virtually and the observable acts on
+ * the qubits in the order given by the output permutation of the circuit.
+ * Garbage qubits are not reduced.
+ * @param qc The parametrized circuit
+ * @param in The initial state. Its reference count is not modified.
+ * @param observable The (Hermitian) observable H
+ * @param assignment Values for all variables of the circuit
+ * @param dd The DD package
+ * @return The expectation value and its gradient. Variables that do not occur
+ * in the circuit are not included.
+ * @throws std::invalid_argument if the circuit contains non-unitary
+ * operations, symbolic operations nested in compound operations, symbolic
+ * gates other than (controlled) rotations and phase gates, or if a variable
+ * is not assigned
+ */
+template <class Config>
+GradientResult computeGradient(const qc::QuantumComputation& qc,
+                               const vEdge& in, const mEdge& observable,
+                               const qc::VariableAssignment& assignment,
+                               Package<Config>& dd);
+
+} // namespace dd
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/Node.hpp"
+#include "dd/Package_fwd.hpp"
+#include "ir/Permutation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Expression.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace dd {
+
+/**
+ * @brief Repeated simulation of a parametrized circuit
+ * @details Variational algorithms simulate the same circuit over and over,
+ * where only a few of the parameters of its symbolic operations change between
+ * two runs. The simulator stores the intermediate state (and permutation)
+ * before every `interval`-th operation of the most recent run. When the
+ * circuit is simulated again, the first operation that depends on a changed
+ * variable is determined and the simulation resumes from the last checkpoint
+ * before it, so only the remaining operations are applied.
+ *
+ * Symbolic operations are instantiated with the given assignment on the fly;
+ * the circuit itself is never modified. Uncontrolled SWAP gates are executed
+ * virtually, as in the regular simulation. The checkpoints keep their states
+ * referenced, which bounds the memory overhead to about `n / interval` states
+ * for a circuit with n operations.
+ */
+template <class Config> class IncrementalSimulator {
+public:
+  /**
+   * @param qc The parametrized circuit. It has to outlive the simulator.
+   * @param in The initial state. The simulator keeps its own reference.
+   * @param dd The DD package
+   * @param interval The number of operations between two checkpoints (0 uses
+   * the square root of the number of operations)
+   * @throws std::invalid_argument if the circuit contains non-unitary
+   * operations or symbolic operations nested in compound operations
+   */
+  IncrementalSimulator(const qc::QuantumComputation& qc, const vEdge& in,
+                       Package<Config>& dd, std::size_t interval = 0U);
+  ~IncrementalSimulator();
+
+  IncrementalSimulator(const IncrementalSimulator&) = delete;
+  IncrementalSimulator& operator=(const IncrementalSimulator&) = delete;
+
+  /**
+   * @brief Simulate the circuit for an assignment of its variables
+   * @param assignment Values for all variables of the circuit
+   * @return The final state. Its reference count is increased, as for
+   * simulate().
+   * @throws std::invalid_argument if a variable of the circuit is not
+   * assigned
+   */
+  vEdge simulate(const qc::VariableAssignment& assignment);
+
+  /// The number of operations that have been applied by the last simulation
+  [[nodiscard]] std::size_t appliedOperations() const noexcept {
+    return applied;
+  }
+
+  /// The number of checkpoints that are currently stored
+  [[nodiscard]] std::size_t numCheckpoints() const noexcept {
+    return checkpoints.size();
+  }
+
+private:
+  struct Snapshot {
+    vEdge state{};
+    qc::Permutation permutation{};
+  };
+
+  const qc::QuantumComputation* qc;
+  Package<Config>* dd;
+  std::size_t interval;
+  /// checkpoints[k] is the state before operation k * interval
+  std::vector<Snapshot> checkpoints;
+  /// The index of the first operation that depends on each variable
+  std::unordered_map<sym::Variable, std::size_t> firstUse;
+  /// The assignment of the most recent simulation
+  std::optional<qc::VariableAssignment> previous;
+  std::size_t applied = 0U;
+
+  /// The index of the first operation affected by the new assignment
+  [[nodiscard]] std::size_t
+  firstAffected(const qc::VariableAssignment& assignment) const;
+};
+
+} // namespace dd
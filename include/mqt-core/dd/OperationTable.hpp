@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "Definitions.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/statistics/TableStatistics.hpp"
+#include "ir/operations/Control.hpp"
+#include "ir/operations/OpType.hpp"
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace dd {
+
+/**
+ * @brief Data structure for caching the DDs of standard operations
+ * @details Entries are identified by the operation type, its parameters, the
+ * (already permuted) targets and controls, and whether the inverse operation
+ * was requested. In contrast to the compute tables, the cached DDs are meant
+ * to be kept alive via reference counting by the owning package. Consequently,
+ * evicted entries are handed back on insertion so that their references can be
+ * released.
+ * @tparam Edge type of the cached DDs
+ * @tparam NBUCKET number of hash buckets to use (has to be a power of two)
+ */
+template <class Edge, std::size_t NBUCKET = 1024U> class OperationTable {
+public:
+  OperationTable() {
+    stats.entrySize = sizeof(Entry);
+    stats.numBuckets = NBUCKET;
+  }
+
+  struct Entry {
+    qc::OpType type = qc::OpType::None;
+    std::vector<fp> parameter;
+    std::vector<qc::Qubit> targets;
+    qc::Controls controls;
+    bool inverse = false;
+    Edge result{};
+  };
+
+  static constexpr std::size_t MASK = NBUCKET - 1;
+
+  static std::size_t hash(const qc::OpType type,
+                          const std::vector<fp>& parameter,
+                          const std::vector<qc::Qubit>& targets,
+                          const qc::Controls& controls, const bool inverse) {
+    auto h = qc::combineHash(static_cast<std::size_t>(type),
+                             static_cast<std::size_t>(inverse));
+    for (const auto& p : parameter) {
+      h = qc::combineHash(h, std::hash<fp>{}(p));
+    }
+    for (const auto& t : targets) {
+      h = qc::combineHash(h, static_cast<std::size_t>(t));
+    }
+    for (const auto& c : controls) {
+      h = qc::combineHash(h, std::hash<qc::Control>{}(c));
+    }
+    return h & MASK;
+  }
+
+  /// Get a reference to the table
+  [[nodiscard]] const auto& getTable() const { return table; }
+
+  /// Get a reference to the statistics
+  [[nodiscard]] const auto& getStats() const noexcept { return stats; }
+
+  /**
+   * @brief Insert a DD into the table
+   * @return The DD that was evicted from the table (a default-constructed
+   * edge if the bucket was empty)
+   */
+  Edge insert(const qc::OpType type, const std::vector<fp>& parameter,
+              const std::vector<qc::Qubit>& targets,
+              const qc::Controls& controls, const bool inverse,
+              const Edge& result) {
+    const auto key = hash(type, parameter, targets, controls, inverse);
+    auto& entry = table[key];
+    Edge evicted{};
+    if (valid[key]) {
+      ++stats.collisions;
+      evicted = entry.result;
+    } else {
+      stats.trackInsert();
+      valid.set(key);
+    }
+    entry.type = type;
+    entry.parameter = parameter;
+    entry.targets = targets;
+    entry.controls = controls;
+    entry.inverse = inverse;
+    entry.result = result;
+    return evicted;
+  }
+
+  const Edge* lookup(const qc::OpType type, const std::vector<fp>& parameter,
+                     const std::vector<qc::Qubit>& targets,
+                     const qc::Controls& controls, const bool inverse) {
+    ++stats.lookups;
+    const auto key = hash(type, parameter, targets, controls, inverse);
+    if (!valid[key]) {
+      return nullptr;
+    }
+    const auto& entry = table[key];
+    if (entry.type != type || entry.inverse != inverse ||
+        entry.parameter != parameter || entry.targets != targets ||
+        entry.controls != controls) {
+      return nullptr;
+    }
+    ++stats.hits;
+    return &entry.result;
+  }
+
+  /// Call @p f for the DD of every valid entry
+  template <class Function> void forEach(Function&& f) const {
+    if (stats.numEntries == 0U) {
+      return;
+    }
+    for (std::size_t i = 0U; i < NBUCKET; ++i) {
+      if (valid[i]) {
+        std::invoke(f, table[i].result);
+      }
+    }
+  }
+
+  void clear() {
+    valid.reset();
+    stats.reset();
+  }
+
+private:
+  std::array<Entry, NBUCKET> table{};
+  std::bitset<NBUCKET> valid{};
+  TableStatistics stats{};
+};
+} // namespace dd
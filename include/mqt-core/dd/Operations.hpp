@@ -14,6 +14,7 @@
 #include "dd/Edge.hpp"
 #include "dd/GateMatrixDefinitions.hpp"
 #include "dd/Package.hpp"
+#include "dd/statistics/Tracer.hpp"
 #include "ir/Permutation.hpp"
 #include "ir/operations/ClassicControlledOperation.hpp"
 #include "ir/operations/CompoundOperation.hpp"
@@ -23,6 +24,7 @@
 #include "ir/operations/Operation.hpp"
 #include "ir/operations/StandardOperation.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -34,12 +36,9 @@
 #include <vector>
 
 namespace dd {
-// single-target Operations
-template <class Config>
-qc::MatrixDD
-getStandardOperationDD(const qc::StandardOperation* op, Package<Config>& dd,
-                       const qc::Controls& controls, const qc::Qubit target,
-                       const bool inverse) {
+// matrix of single-target Operations
+inline GateMatrix getStandardOperationMatrix(const qc::StandardOperation* op,
+                                             const bool inverse) {
   GateMatrix gm;
 
   const auto type = op->getType();
@@ -110,7 +109,17 @@ getStandardOperationDD(const qc::StandardOperation* op, Package<Config>& dd,
     oss << "DD for gate" << op->getName() << " not available!";
     throw qc::QFRException(oss.str());
   }
-  return dd.makeGateDD(gm, controls, target);
+  return gm;
+}
+
+// single-target Operations
+template <class Config>
+qc::MatrixDD
+getStandardOperationDD(const qc::StandardOperation* op, Package<Config>& dd,
+                       const qc::Controls& controls, const qc::Qubit target,
+                       const bool inverse) {
+  return dd.makeGateDD(getStandardOperationMatrix(op, inverse), controls,
+                       target);
 }
 
 // two-target Operations
@@ -209,15 +218,30 @@ qc::MatrixDD getDD(const qc::Operation* op, Package<Config>& dd,
     const auto* standardOp = dynamic_cast<const qc::StandardOperation*>(op);
     const auto& targets = permutation.apply(op->getTargets());
     const auto& controls = permutation.apply(op->getControls());
+    const auto& parameter = op->getParameter();
 
+    // reuse the DD of an identical operation if it is still cached
+    if (const auto* cached = dd.operationTable.lookup(
+            type, parameter, targets, controls, inverse);
+        cached != nullptr) {
+      return *cached;
+    }
+
+    qc::MatrixDD e{};
     if (qc::isTwoQubitGate(type)) {
       assert(targets.size() == 2);
-      return getStandardOperationDD(standardOp, dd, controls, targets[0U],
-                                    targets[1U], inverse);
+      e = getStandardOperationDD(standardOp, dd, controls, targets[0U],
+                                 targets[1U], inverse);
+    } else {
+      assert(targets.size() == 1);
+      e = getStandardOperationDD(standardOp, dd, controls, targets[0U],
+                                 inverse);
     }
-    assert(targets.size() == 1);
-    return getStandardOperationDD(standardOp, dd, controls, targets[0U],
-                                  inverse);
+    // the table holds a reference to the cached DD until it is evicted
+    dd.incRef(e);
+    dd.decRef(dd.operationTable.insert(type, parameter, targets, controls,
+                                       inverse, e));
+    return e;
   }
 
   if (op->isCompoundOperation()) {
@@ -251,15 +275,82 @@ qc::MatrixDD getInverseDD(const qc::Operation* op, Package<Config>& dd,
   return getDD(op, dd, permutation, true);
 }
 
+/**
+ * @brief Whether an operation is applied to vector DDs without constructing
+ * its DD
+ * @details Single-target gates and SWAPs are applied directly to the state
+ * (see Package::applyGate() and Package::applySwapGate()).
+ */
+inline bool isAppliedDirectly(const qc::Operation* op) {
+  const auto type = op->getType();
+  return op->isStandardOperation() && type != qc::GPhase &&
+         type != qc::Barrier &&
+         (type == qc::SWAP || !qc::isTwoQubitGate(type));
+}
+
 template <class Config, class Node>
-Edge<Node> applyUnitaryOperation(const qc::Operation* op, const Edge<Node>& in,
-                                 Package<Config>& dd,
-                                 const qc::Permutation& permutation = {}) {
+Edge<Node> applyUnitaryOperationUntraced(const qc::Operation* op,
+                                         const Edge<Node>& in,
+                                         Package<Config>& dd,
+                                         const qc::Permutation& permutation) {
   static_assert(std::is_same_v<Node, dd::vNode> ||
                 std::is_same_v<Node, dd::mNode>);
+  if constexpr (std::is_same_v<Node, dd::vNode>) {
+    if (isAppliedDirectly(op)) {
+      const auto type = op->getType();
+      const auto& controls = permutation.apply(op->getControls());
+      const auto& targets = permutation.apply(op->getTargets());
+      Edge<Node> r{};
+      if (type == qc::SWAP) {
+        r = dd.applySwapGate(controls, targets[0], targets[1], in);
+      } else {
+        using GateKind = typename Package<Config>::GateKind;
+        auto kind = GateKind::General;
+        if (std::find(qc::DIAGONAL_GATES.begin(), qc::DIAGONAL_GATES.end(),
+                      type) != qc::DIAGONAL_GATES.end()) {
+          kind = GateKind::Diagonal;
+        } else if (type == qc::X || type == qc::Y) {
+          kind = GateKind::AntiDiagonal;
+        }
+        const auto* standardOp = dynamic_cast<const qc::StandardOperation*>(op);
+        r = dd.applyGate(getStandardOperationMatrix(standardOp, false),
+                         controls, targets.front(), in, kind);
+      }
+      dd.incRef(r);
+      dd.decRef(in);
+      dd.garbageCollect();
+      return r;
+    }
+  }
   return dd.applyOperation(getDD(op, dd, permutation), in);
 }
 
+/**
+ * @brief Apply a unitary operation to a vector or matrix DD
+ * @details The reference of @p in is transferred to the result. If a tracer is
+ * attached to @p dd, the operation is recorded (see Package::setTracer).
+ * Likewise, the resulting DD size is recorded by an attached size profiler
+ * (see Package::setSizeProfiler).
+ */
+template <class Config, class Node>
+Edge<Node> applyUnitaryOperation(const qc::Operation* op, const Edge<Node>& in,
+                                 Package<Config>& dd,
+                                 const qc::Permutation& permutation = {}) {
+  Edge<Node> r{};
+  if (dd.getTracer() == nullptr) {
+    r = applyUnitaryOperationUntraced(op, in, dd, permutation);
+  } else {
+    const auto snapshot = dd.traceBegin();
+    r = applyUnitaryOperationUntraced(op, in, dd, permutation);
+    TraceEvent event{};
+    event.name = op->getName();
+    // the size is determined after the timing has been recorded
+    dd.traceEnd(snapshot, std::move(event)).ddSize = r.size();
+  }
+  dd.template recordSize<Node>(op->getName());
+  return r;
+}
+
 template <class Config>
 qc::VectorDD applyMeasurement(const qc::Operation* op, qc::VectorDD in,
                               Package<Config>& dd, std::mt19937_64& rng,
@@ -22,12 +22,16 @@
 #include "dd/GateMatrixDefinitions.hpp"
 #include "dd/MemoryManager.hpp"
 #include "dd/Node.hpp"
+#include "dd/OperationTable.hpp"
 #include "dd/Package_fwd.hpp" // IWYU pragma: export
 #include "dd/RealNumber.hpp"
 #include "dd/RealNumberUniqueTable.hpp"
 #include "dd/StochasticNoiseOperationTable.hpp"
 #include "dd/UnaryComputeTable.hpp"
 #include "dd/UniqueTable.hpp"
+#include "dd/statistics/SizeProfiler.hpp"
+#include "dd/statistics/TableStatistics.hpp"
+#include "dd/statistics/Tracer.hpp"
 #include "ir/Permutation.hpp"
 #include "ir/operations/Control.hpp"
 
@@ -43,6 +47,7 @@
 #include <iterator>
 #include <limits>
 #include <map>
+#include <optional>
 #include <queue>
 #include <random>
 #include <regex>
@@ -70,6 +75,7 @@ public:
       static_cast<std::size_t>(std::numeric_limits<Qubit>::max()) + 1U;
   static constexpr std::size_t DEFAULT_QUBITS = 32U;
   explicit Package(std::size_t nq = DEFAULT_QUBITS) : nqubits(nq) {
+    cUniqueTable.setExactLookups(Config::EXACT_WEIGHTS);
     resize(nq);
   };
   ~Package() = default;
@@ -96,6 +102,7 @@ public:
 
   // reset package state
   void reset() {
+    operationTable.clear();
     clearUniqueTables();
     resetMemoryManagers();
     clearComputeTables();
@@ -183,6 +190,20 @@ public:
     }
   }
 
+  /**
+   * @brief Check whether a DD has more than @p limit nodes
+   * @details Every node of the DD is contained in the unique table, so the
+   * number of table entries (plus the terminal) bounds the size of the DD.
+   * The DD is only traversed if this bound exceeds @p limit.
+   */
+  template <class Node>
+  [[nodiscard]] bool exceedsSize(const Edge<Node>& e, const std::size_t limit) {
+    if (getUniqueTable<Node>().getNumEntries() + 1U <= limit) {
+      return false;
+    }
+    return e.size() > limit;
+  }
+
   /**
    * @brief Clear all unique tables
    * @see UniqueTable::clear
@@ -237,6 +258,50 @@ public:
     }
   }
 
+  /**
+   * @brief Freeze a DD such that other packages can use it as an operand
+   * @details The reference counts of all nodes and edge weights of @p e are
+   * saturated. Saturated reference counts are never modified, so that the DD
+   * is never garbage collected and other packages may reference its nodes
+   * without writing to them. Hence, a large DD (e.g., the unitary of an
+   * oracle) can be built once and then be read concurrently by worker
+   * packages in different threads instead of transferring a copy into each
+   * of them. Any DD created by an operation involving the frozen DD is owned
+   * and cached by the package performing the operation.
+   * @note Freezing cannot be undone. The frozen DD remains allocated until
+   * this package is reset or destroyed, which must not happen while other
+   * packages still use it. Packages using a frozen DD need to support at least
+   * as many qubits as the DD.
+   * @tparam Node The node type of the edge.
+   * @param e The edge to freeze
+   */
+  template <class Node> void freeze(const Edge<Node>& e) {
+    // activate all entries first to keep the table statistics consistent
+    incRef(e);
+    std::unordered_set<const Node*> visited{};
+    freezeRecursive(e, visited);
+  }
+
+private:
+  template <class Node>
+  void freezeRecursive(const Edge<Node>& e,
+                       std::unordered_set<const Node*>& visited) {
+    for (const auto* num : {e.w.r, e.w.i}) {
+      if (auto* const ptr = RealNumber::getAlignedPointer(num);
+          !RealNumber::noRefCountingNeeded(ptr)) {
+        ptr->ref = std::numeric_limits<RefCount>::max();
+      }
+    }
+    if (e.isTerminal() || !visited.emplace(e.p).second) {
+      return;
+    }
+    e.p->ref = std::numeric_limits<RefCount>::max();
+    for (const auto& child : e.p->e) {
+      freezeRecursive(child, visited);
+    }
+  }
+
+public:
   bool garbageCollect(bool force = false) {
     // return immediately if no table needs collection
     if (!force && !vUniqueTable.possiblyNeedsCollection() &&
@@ -246,6 +311,17 @@ public:
       return false;
     }
 
+    TraceSnapshot snapshot{};
+    if (tracer != nullptr) {
+      snapshot = traceBegin();
+    }
+
+    // cached operation DDs are only kept alive as long as no collection is
+    // forced
+    if (force) {
+      clearOperationTable();
+    }
+
     auto cCollect = cUniqueTable.garbageCollect(force);
     if (cCollect > 0) {
       // Collecting garbage in the complex numbers table requires collecting the
@@ -263,6 +339,8 @@ public:
       vectorInnerProduct.clear();
       vectorKronecker.clear();
       matrixVectorMultiplication.clear();
+      // forces the direct gate application tables to be cleared before use
+      tabulatedGate.reset();
     }
     // invalidate all compute tables involving matrices if any matrix node has
     // been collected
@@ -299,9 +377,123 @@ public:
       densityNoise.clear();
       densityTrace.clear();
     }
+
+    if (tracer != nullptr) {
+      TraceEvent event{};
+      event.type = TraceEvent::Type::GarbageCollection;
+      event.name = "garbage_collection";
+      event.collected = vCollect + mCollect + dCollect + cCollect;
+      traceEnd(snapshot, std::move(event));
+    }
     return vCollect > 0 || mCollect > 0 || cCollect > 0;
   }
 
+  ///
+  /// Tracing
+  ///
+  /// State of the package at the beginning of a traced event
+  struct TraceSnapshot {
+    double start = 0.;
+    std::size_t uniqueTableEntries = 0U;
+    std::size_t computeTableLookups = 0U;
+    std::size_t computeTableHits = 0U;
+  };
+
+  /**
+   * @brief Attach a tracer to the package
+   * @details While a tracer is attached, operations applied via
+   * applyUnitaryOperation and garbage collection runs are recorded. The tracer
+   * is not owned by the package and has to outlive it (or be detached).
+   * @param t The tracer to attach (nullptr disables tracing)
+   */
+  void setTracer(Tracer* t) noexcept { tracer = t; }
+  [[nodiscard]] Tracer* getTracer() const noexcept { return tracer; }
+
+  /// Capture the state of the package at the beginning of a traced event
+  [[nodiscard]] TraceSnapshot traceBegin() const {
+    assert(tracer != nullptr);
+    TraceSnapshot snapshot{};
+    snapshot.uniqueTableEntries = vUniqueTable.getNumEntries() +
+                                  mUniqueTable.getNumEntries() +
+                                  dUniqueTable.getNumEntries();
+    forEachComputeTableStatistics([&snapshot](const TableStatistics& stats) {
+      snapshot.computeTableLookups += stats.lookups;
+      snapshot.computeTableHits += stats.hits;
+    });
+    snapshot.start = tracer->now();
+    return snapshot;
+  }
+
+  /**
+   * @brief Record an event that started with the given snapshot
+   * @details The timing information, the unique table growth, and the compute
+   * table lookups/hits of @p event are filled in based on @p snapshot.
+   * @return A reference to the recorded event
+   */
+  TraceEvent& traceEnd(const TraceSnapshot& snapshot, TraceEvent event) {
+    assert(tracer != nullptr);
+    event.start = snapshot.start;
+    event.duration = tracer->now() - snapshot.start;
+    const auto uniqueTableEntries = vUniqueTable.getNumEntries() +
+                                    mUniqueTable.getNumEntries() +
+                                    dUniqueTable.getNumEntries();
+    event.uniqueTableGrowth =
+        static_cast<std::int64_t>(uniqueTableEntries) -
+        static_cast<std::int64_t>(snapshot.uniqueTableEntries);
+    forEachComputeTableStatistics([&event](const TableStatistics& stats) {
+      event.computeTableLookups += stats.lookups;
+      event.computeTableHits += stats.hits;
+    });
+    event.computeTableLookups -= snapshot.computeTableLookups;
+    event.computeTableHits -= snapshot.computeTableHits;
+    return tracer->record(std::move(event));
+  }
+
+  /**
+   * @brief Attach a size profiler to the package
+   * @details While a profiler is attached, the number of referenced nodes per
+   * level is recorded after every operation applied via applyUnitaryOperation.
+   * The profiler is not owned by the package and has to outlive it (or be
+   * detached).
+   * @param p The profiler to attach (nullptr disables profiling)
+   */
+  void setSizeProfiler(SizeProfiler* p) noexcept { sizeProfiler = p; }
+  [[nodiscard]] SizeProfiler* getSizeProfiler() const noexcept {
+    return sizeProfiler;
+  }
+
+  /// Record the current size of all referenced DDs of the given node type
+  template <class Node> void recordSize(const std::string& name) {
+    if (sizeProfiler != nullptr) {
+      sizeProfiler->record(name, getUniqueTable<Node>().getStats());
+    }
+  }
+
+private:
+  Tracer* tracer = nullptr;
+  SizeProfiler* sizeProfiler = nullptr;
+
+  template <class Function>
+  void forEachComputeTableStatistics(Function&& f) const {
+    f(vectorAdd.getStats());
+    f(matrixAdd.getStats());
+    f(densityAdd.getStats());
+    f(conjugateMatrixTranspose.getStats());
+    f(matrixVectorMultiplication.getStats());
+    f(matrixMatrixMultiplication.getStats());
+    f(densityDensityMultiplication.getStats());
+    f(vectorKronecker.getStats());
+    f(matrixKronecker.getStats());
+    f(vectorInnerProduct.getStats());
+    f(vectorGateApplication.getStats());
+    f(vectorDiagonalGateApplication.getStats());
+    f(vectorPermutationGateApplication.getStats());
+    f(vectorGatePairApplication.getStats());
+    f(operationTable.getStats());
+  }
+
+public:
+
   ///
   /// Vector nodes, edges and quantum states
   ///
@@ -857,32 +1049,32 @@ public:
   template <class Node>
   Edge<Node> deleteEdge(const Edge<Node>& e, const Qubit v,
                         const std::size_t edgeIdx) {
-    std::unordered_map<Node*, Edge<Node>> nodes{};
-    return deleteEdge(e, v, edgeIdx, nodes);
+    std::unordered_map<Node*, CachedEdge<Node>> nodes{};
+    return cn.lookup(deleteEdge(e, v, edgeIdx, nodes));
   }
 
 private:
   template <class Node>
-  Edge<Node> deleteEdge(const Edge<Node>& e, const Qubit v,
-                        const std::size_t edgeIdx,
-                        std::unordered_map<Node*, Edge<Node>>& nodes) {
+  CachedEdge<Node>
+  deleteEdge(const Edge<Node>& e, const Qubit v, const std::size_t edgeIdx,
+             std::unordered_map<Node*, CachedEdge<Node>>& nodes) {
     if (e.isTerminal()) {
-      return e;
+      return {e.p, e.w};
     }
 
     const auto& nodeIt = nodes.find(e.p);
-    Edge<Node> r{};
+    CachedEdge<Node> r{};
     if (nodeIt != nodes.end()) {
       r = nodeIt->second;
     } else {
       constexpr std::size_t n = std::tuple_size_v<decltype(e.p->e)>;
-      std::array<Edge<Node>, n> edges{};
+      std::array<CachedEdge<Node>, n> edges{};
       if (e.p->v == v) {
         for (std::size_t i = 0; i < n; i++) {
-          edges[i] = i == edgeIdx
-                         ? Edge<Node>::zero()
-                         : e.p->e[i]; // optimization -> node cannot occur below
-                                      // again, since dd is assumed to be free
+          // optimization -> node cannot occur below again, since dd is assumed
+          // to be free
+          edges[i] = i == edgeIdx ? CachedEdge<Node>::zero()
+                                  : CachedEdge<Node>{e.p->e[i].p, e.p->e[i].w};
         }
       } else {
         for (std::size_t i = 0; i < n; i++) {
@@ -893,7 +1085,7 @@ private:
       r = makeDDNode(e.p->v, edges);
       nodes[e.p] = r;
     }
-    r.w = cn.lookup(r.w * e.w);
+    r.w = r.w * e.w;
     return r;
   }
 
@@ -914,6 +1106,11 @@ public:
     vectorKronecker.clear();
     matrixKronecker.clear();
     matrixTrace.clear();
+    vectorGateApplication.clear();
+    vectorDiagonalGateApplication.clear();
+    vectorPermutationGateApplication.clear();
+    vectorGatePairApplication.clear();
+    tabulatedGate.reset();
 
     stochasticNoiseOperationCache.clear();
     densityAdd.clear();
@@ -1142,6 +1339,32 @@ public:
     return measuredResult;
   }
 
+private:
+  /**
+   * @brief Projects a state onto one outcome of a single-qubit measurement.
+   * @details Applies the corresponding projector and renormalizes the result.
+   * The product is kept as a cached edge so that only the renormalized root
+   * weight is looked up in the real number table.
+   * @param rootEdge the root edge of the state vector decision diagram
+   * @param index the index of the measured qubit
+   * @param measureZero whether to project onto '0' (otherwise '1')
+   * @param probability the probability of the outcome (must be non-zero)
+   * @return the normalized post-measurement state
+   */
+  vEdge project(const vEdge& rootEdge, const Qubit index,
+                const bool measureZero, const fp probability) {
+    const auto gate =
+        makeGateDD(measureZero ? MEAS_ZERO_MAT : MEAS_ONE_MAT, index);
+    Qubit var = gate.p->v;
+    if (!rootEdge.isTerminal() && rootEdge.p->v > var) {
+      var = rootEdge.p->v;
+    }
+    auto r = multiply2(gate, rootEdge, var);
+    r.w = r.w / std::sqrt(probability);
+    return cn.lookup(r);
+  }
+
+public:
   /**
    * @brief Performs a specific measurement on the given state vector decision
    * diagram. Collapses the state according to the measurement result.
@@ -1155,15 +1378,8 @@ public:
   void performCollapsingMeasurement(vEdge& rootEdge, const Qubit index,
                                     const fp probability,
                                     const bool measureZero) {
-    const GateMatrix measurementMatrix =
-        measureZero ? MEAS_ZERO_MAT : MEAS_ONE_MAT;
-
-    const auto measurementGate = makeGateDD(measurementMatrix, index);
-
-    vEdge e = multiply(measurementGate, rootEdge);
-
     assert(probability > 0.);
-    e.w = cn.lookup(e.w / std::sqrt(probability));
+    const auto e = project(rootEdge, index, measureZero, probability);
     incRef(e);
     decRef(rootEdge);
     rootEdge = e;
@@ -1179,21 +1395,17 @@ public:
           std::to_string(pzero) + " + " + std::to_string(pone) + " = " +
           std::to_string(pzero + pone) + ", but should be 1!");
     }
-    const auto measZeroGate = makeGateDD(MEAS_ZERO_MAT, index);
-    const auto measOneGate = makeGateDD(MEAS_ONE_MAT, index);
     vEdge v0;
     vEdge v1;
     if (pzero == 0.0) {
       v0 = Edge<vNode>::zero();
     } else {
-      v0 = multiply(measZeroGate, rootEdge);
-      v0.w = cn.lookup(v0.w / std::sqrt(pzero));
+      v0 = project(rootEdge, index, true, pzero);
     }
     if (pone == 0.0) {
       v1 = Edge<vNode>::zero();
     } else {
-      v1 = multiply(measOneGate, rootEdge);
-      v1.w = cn.lookup(v1.w / std::sqrt(pone));
+      v1 = project(rootEdge, index, false, pone);
     }
     return std::make_tuple(v0, pzero, v1, pone);
   }
@@ -1216,20 +1428,11 @@ public:
           std::to_string(pzero) + " + " + std::to_string(pone) + " = " +
           std::to_string(pzero + pone) + ", but should be 1!");
     }
-    const GateMatrix measurementMatrix =
-        measureZero ? MEAS_ZERO_MAT : MEAS_ONE_MAT;
-    const auto measurementGate = makeGateDD(measurementMatrix, index);
-    vEdge e = multiply(measurementGate, rootEdge);
-    // normalize
     const fp probability = measureZero ? pzero : pone;
     if (probability == 0.0) {
       return Edge<vNode>::zero();
     }
-    e.w = cn.lookup(e.w / std::sqrt(probability));
-    // incRef(e);
-    // decRef(rootEdge);
-    // rootEdge = e;
-    return e;
+    return project(rootEdge, index, measureZero, probability);
   }
 
   // outer for one qubit state
@@ -1240,13 +1443,16 @@ public:
           "Cannot compute outer product for multiple-qubits state vector decision "
           "diagram.");
     }
-    auto a = cn.lookup(rootEdge.w * rootEdge.p->e[0].w);
-    auto b = cn.lookup(rootEdge.w * rootEdge.p->e[1].w);
+    // the amplitudes are only needed as values (no table lookups required)
+    const auto a =
+        static_cast<std::complex<fp>>(rootEdge.w * rootEdge.p->e[0].w);
+    const auto b =
+        static_cast<std::complex<fp>>(rootEdge.w * rootEdge.p->e[1].w);
     GateMatrix outerMatrix{};
-    outerMatrix[0] = ComplexNumbers::mag2(a);
-    outerMatrix[1] = std::complex<fp>(RealNumber::val(a.r), RealNumber::val(a.i)) * std::complex<fp>(RealNumber::val(b.r), -RealNumber::val(b.i));
-    outerMatrix[2] = std::complex<fp>(RealNumber::val(b.r), RealNumber::val(b.i)) * std::complex<fp>(RealNumber::val(a.r), -RealNumber::val(a.i));
-    outerMatrix[3] = ComplexNumbers::mag2(b);
+    outerMatrix[0] = std::norm(a);
+    outerMatrix[1] = a * std::conj(b);
+    outerMatrix[2] = b * std::conj(a);
+    outerMatrix[3] = std::norm(b);
     auto gateDD = makeGateDD(outerMatrix, target);
     if (gateDD.p->ref == 0) {
       incRef(gateDD);
@@ -1603,6 +1809,372 @@ public:
     return tmp;
   }
 
+  ///
+  /// Direct gate application
+  ///
+public:
+  /// Structure of a gate that is applied directly to a vector DD
+  enum class GateKind : std::uint8_t {
+    /// arbitrary single-target gate
+    General,
+    /// diagonal single-target gate (e.g., Z, S, T, P, RZ)
+    Diagonal,
+    /// anti-diagonal single-target gate, i.e., a bit flip with phases (X, Y)
+    AntiDiagonal,
+    /// exchange of two target qubits (SWAP)
+    Swap
+  };
+
+private:
+  /// Role of a qubit with respect to a gate that is applied directly
+  enum class GateLevel : std::uint8_t { None, PosControl, NegControl };
+
+  /// Description of a gate that is applied directly to a vector DD
+  struct DirectGate {
+    GateKind kind = GateKind::General;
+    std::array<ComplexValue, NEDGE> mat{};
+    /// the (upper) target qubit of the gate
+    Qubit target{};
+    /// the lower target qubit of a two-target gate (equals target otherwise)
+    Qubit lowerTarget{};
+    /// role of every qubit with respect to the gate
+    std::vector<GateLevel> levels;
+    /// lowest control qubit below the lower target (the lower target if there
+    /// is none)
+    Qubit lowest{};
+
+    /// whether the successor @p i at @p level is unaffected by the gate
+    [[nodiscard]] bool inactive(const Qubit level, const std::size_t i) const {
+      const auto role = levels[level];
+      return (role == GateLevel::PosControl && i == 0U) ||
+             (role == GateLevel::NegControl && i == 1U);
+    }
+
+    [[nodiscard]] bool operator==(const DirectGate& other) const {
+      return kind == other.kind && mat == other.mat && target == other.target &&
+             lowerTarget == other.lowerTarget && levels == other.levels;
+    }
+  };
+
+public:
+  UnaryComputeTable<vNode*, vCachedEdge, Config::CT_VEC_GATE_NBUCKET>
+      vectorGateApplication{};
+  UnaryComputeTable<vNode*, vCachedEdge, Config::CT_VEC_GATE_NBUCKET>
+      vectorDiagonalGateApplication{};
+  UnaryComputeTable<vNode*, vCachedEdge, Config::CT_VEC_GATE_NBUCKET>
+      vectorPermutationGateApplication{};
+  ComputeTable<vCachedEdge, vCachedEdge, std::array<vCachedEdge, RADIX>,
+               Config::CT_VEC_GATE_NBUCKET>
+      vectorGatePairApplication{};
+
+  [[nodiscard]] auto& getGateApplicationComputeTable(const GateKind kind) {
+    switch (kind) {
+    case GateKind::Diagonal:
+      return vectorDiagonalGateApplication;
+    case GateKind::AntiDiagonal:
+    case GateKind::Swap:
+      return vectorPermutationGateApplication;
+    default:
+      return vectorGateApplication;
+    }
+  }
+
+  /**
+   * @brief Apply a (controlled) single-qubit gate directly to a vector DD
+   * @details In contrast to applyOperation, no DD for the gate is constructed.
+   * Instead, the vector DD is traversed down to the target level, where the
+   * pairs of successors are combined according to the gate matrix. Levels
+   * below the target are only visited if they contain controls. Diagonal and
+   * anti-diagonal gates (as indicated by @p kind) merely rescale or swap the
+   * successors, which avoids any additions. Results are memoized in dedicated
+   * compute tables that hold the results of the most recently applied gate.
+   * Hence, applying the same gate to several states that share sub-DDs reuses
+   * the results for the shared parts.
+   * @param mat The matrix of the gate
+   * @param controls The controls of the gate
+   * @param target The target qubit of the gate
+   * @param in The vector DD the gate is applied to
+   * @param kind The structure of the gate matrix
+   * @return The resulting vector DD. Reference counts are not modified.
+   */
+  vEdge applyGate(const GateMatrix& mat, const qc::Controls& controls,
+                  const qc::Qubit target, const vEdge& in,
+                  const GateKind kind = GateKind::General) {
+    assert(kind != GateKind::Swap);
+    assert(kind != GateKind::Diagonal ||
+           (mat[1] == std::complex<fp>{} && mat[2] == std::complex<fp>{}));
+    assert(kind != GateKind::AntiDiagonal ||
+           (mat[0] == std::complex<fp>{} && mat[3] == std::complex<fp>{}));
+    if (in.isTerminal()) {
+      return in;
+    }
+    auto gate = makeDirectGate(kind, controls, target, target, in);
+    for (std::size_t i = 0U; i < NEDGE; ++i) {
+      gate.mat[i] = ComplexValue{mat[i]};
+    }
+    return applyDirectGate(gate, in);
+  }
+
+  /**
+   * @brief Apply a (controlled) SWAP gate directly to a vector DD
+   * @details The successors of the nodes at the upper target level are
+   * traversed simultaneously down to the lower target level, where the
+   * sub-vectors corresponding to |01> and |10> are exchanged.
+   * @param controls The controls of the gate
+   * @param target0 The first target qubit
+   * @param target1 The second target qubit
+   * @param in The vector DD the gate is applied to
+   * @return The resulting vector DD. Reference counts are not modified.
+   */
+  vEdge applySwapGate(const qc::Controls& controls, const qc::Qubit target0,
+                      const qc::Qubit target1, const vEdge& in) {
+    if (in.isTerminal() || target0 == target1) {
+      return in;
+    }
+    auto gate = makeDirectGate(GateKind::Swap, controls,
+                               std::max(target0, target1),
+                               std::min(target0, target1), in);
+    // below the lower target, the exchange acts like an X gate
+    for (std::size_t i = 0U; i < NEDGE; ++i) {
+      gate.mat[i] = ComplexValue{X_MAT[i]};
+    }
+    return applyDirectGate(gate, in);
+  }
+
+private:
+  DirectGate makeDirectGate(const GateKind kind, const qc::Controls& controls,
+                            const qc::Qubit target, const qc::Qubit lowerTarget,
+                            const vEdge& in) const {
+    if (std::any_of(controls.begin(), controls.end(),
+                    [&in](const auto& c) { return c.qubit > in.p->v; }) ||
+        target > in.p->v) {
+      throw std::runtime_error{
+          "Requested gate acting on qubit(s) with index larger than " +
+          std::to_string(in.p->v) + " of a vector DD with " +
+          std::to_string(in.p->v + 1U) + " qubits."};
+    }
+
+    DirectGate gate{};
+    gate.kind = kind;
+    gate.target = static_cast<Qubit>(target);
+    gate.lowerTarget = static_cast<Qubit>(lowerTarget);
+    gate.lowest = gate.lowerTarget;
+    gate.levels.resize(static_cast<std::size_t>(in.p->v) + 1U,
+                       GateLevel::None);
+    for (const auto& c : controls) {
+      gate.levels[c.qubit] = c.type == qc::Control::Type::Pos
+                                 ? GateLevel::PosControl
+                                 : GateLevel::NegControl;
+      gate.lowest = std::min(gate.lowest, static_cast<Qubit>(c.qubit));
+    }
+    return gate;
+  }
+
+  /// The gate whose results are currently held by the direct gate application
+  /// compute tables (if any)
+  std::optional<DirectGate> tabulatedGate{};
+
+  vEdge applyDirectGate(const DirectGate& gate, const vEdge& in) {
+    // the results are kept while the same gate is applied repeatedly (e.g., to
+    // all states of a batch)
+    if (!tabulatedGate.has_value() || !(*tabulatedGate == gate)) {
+      getGateApplicationComputeTable(gate.kind).clear();
+      vectorGatePairApplication.clear();
+      tabulatedGate = gate;
+    }
+    const auto r = applyGateRec(in.p, gate);
+    if (r.w.exactlyZero()) {
+      return vEdge::zero();
+    }
+    return cn.lookup(vCachedEdge{r.p, r.w * in.w});
+  }
+
+  vCachedEdge applyGateRec(vNode* p, const DirectGate& gate) {
+    auto& computeTable = getGateApplicationComputeTable(gate.kind);
+    if (const auto* r = computeTable.lookup(p); r != nullptr) {
+      return *r;
+    }
+
+    vCachedEdge r{};
+    if (p->v == gate.target) {
+      const vCachedEdge x{p->e[0].p, p->e[0].w};
+      const vCachedEdge y{p->e[1].p, p->e[1].w};
+      const auto edges = gate.kind == GateKind::Swap
+                             ? applySwapPair(x, y, p->v, gate)
+                             : applyGatePair(x, y, p->v, gate);
+      r = makeDDNode(p->v, edges);
+    } else {
+      std::array<vCachedEdge, RADIX> edges{};
+      for (std::size_t i = 0U; i < RADIX; ++i) {
+        const auto& s = p->e[i];
+        if (s.w.exactlyZero()) {
+          edges[i] = vCachedEdge::zero();
+        } else if (gate.inactive(p->v, i)) {
+          edges[i] = {s.p, s.w};
+        } else {
+          const auto c = applyGateRec(s.p, gate);
+          edges[i] = c.w.exactlyZero() ? vCachedEdge::zero()
+                                       : vCachedEdge{c.p, c.w * s.w};
+        }
+      }
+      r = makeDDNode(p->v, edges);
+    }
+    computeTable.insert(p, r);
+    return r;
+  }
+
+  static vCachedEdge scaleSuccessor(const vCachedEdge& e,
+                                    const ComplexValue& w) {
+    if (w.exactlyZero() || e.w.exactlyZero()) {
+      return vCachedEdge::zero();
+    }
+    return {e.p, e.w * w};
+  }
+
+  static vCachedEdge getSuccessor(const vCachedEdge& e, const std::size_t i) {
+    if (e.w.exactlyZero()) {
+      return vCachedEdge::zero();
+    }
+    const auto& s = e.p->e[i];
+    if (s.w.exactlyZero()) {
+      return vCachedEdge::zero();
+    }
+    return {s.p, e.w * s.w};
+  }
+
+  /**
+   * @brief Split off a common factor of a pair of sub-vectors
+   * @details The weights of sub-vectors accumulate multiplicatively while
+   * descending below the target. If they were passed on unnormalized, they
+   * would eventually drop below the tolerance of the real number table on deep
+   * DDs (e.g., to 2^-45 after 90 levels of Hadamard gates) and be mistaken for
+   * zero. Normalizing the pair additionally increases the hit rate of the pair
+   * compute table.
+   * @return The factor that has been split off. Afterwards, the first non-zero
+   * weight of @p x and @p y is exactly one.
+   */
+  static ComplexValue normalizePair(vCachedEdge& x, vCachedEdge& y) {
+    if (x.w.exactlyZero()) {
+      const auto factor = y.w;
+      y.w = ComplexValue{1.};
+      return factor;
+    }
+    const auto factor = x.w;
+    x.w = ComplexValue{1.};
+    if (!y.w.exactlyZero()) {
+      y.w = y.w / factor;
+    }
+    return factor;
+  }
+
+  /**
+   * @brief Apply the gate to a pair of sub-vectors
+   * @details @p x and @p y are the successors of a node at level @p level
+   * (the lower target level or a level below). If no controls remain below,
+   * the result is given by the gate matrix: a linear combination of @p x and
+   * @p y for general gates, a rescaling for diagonal gates, and a rescaled
+   * exchange for anti-diagonal gates. Otherwise, both sub-vectors are split at
+   * the next level and the gate is only applied to those parts that satisfy
+   * the controls.
+   */
+  std::array<vCachedEdge, RADIX> applyGatePair(const vCachedEdge& x,
+                                               const vCachedEdge& y,
+                                               const Qubit level,
+                                               const DirectGate& gate) {
+    if (x.w.exactlyZero() && y.w.exactlyZero()) {
+      return {vCachedEdge::zero(), vCachedEdge::zero()};
+    }
+
+    const auto var = static_cast<Qubit>(level - 1U);
+    if (level == gate.lowest) {
+      const auto& m = gate.mat;
+      switch (gate.kind) {
+      case GateKind::Diagonal:
+        return {scaleSuccessor(x, m[0]), scaleSuccessor(y, m[3])};
+      case GateKind::AntiDiagonal:
+      case GateKind::Swap:
+        return {scaleSuccessor(y, m[1]), scaleSuccessor(x, m[2])};
+      default:
+        return {add2(scaleSuccessor(x, m[0]), scaleSuccessor(y, m[1]), var),
+                add2(scaleSuccessor(x, m[2]), scaleSuccessor(y, m[3]), var)};
+      }
+    }
+
+    auto xn = x;
+    auto yn = y;
+    if (const auto factor = normalizePair(xn, yn); !factor.exactlyOne()) {
+      const auto r = applyGatePair(xn, yn, level, gate);
+      return {scaleSuccessor(r[0], factor), scaleSuccessor(r[1], factor)};
+    }
+
+    if (const auto* r = vectorGatePairApplication.lookup(x, y); r != nullptr) {
+      return *r;
+    }
+    std::array<vCachedEdge, RADIX> xs{};
+    std::array<vCachedEdge, RADIX> ys{};
+    for (std::size_t i = 0U; i < RADIX; ++i) {
+      const auto xi = getSuccessor(x, i);
+      const auto yi = getSuccessor(y, i);
+      if (gate.inactive(var, i)) {
+        xs[i] = xi;
+        ys[i] = yi;
+      } else {
+        const auto r = applyGatePair(xi, yi, var, gate);
+        xs[i] = r[0];
+        ys[i] = r[1];
+      }
+    }
+    const std::array r{makeDDNode(var, xs), makeDDNode(var, ys)};
+    vectorGatePairApplication.insert(x, y, r);
+    return r;
+  }
+
+  /**
+   * @brief Apply a SWAP gate to a pair of sub-vectors
+   * @details @p x and @p y are the successors of a node at level @p level
+   * between the upper and the lower target. Both are split until the lower
+   * target is reached, where the |01> part of @p x and the |10> part of @p y
+   * are exchanged (subject to any controls below the lower target).
+   */
+  std::array<vCachedEdge, RADIX> applySwapPair(const vCachedEdge& x,
+                                               const vCachedEdge& y,
+                                               const Qubit level,
+                                               const DirectGate& gate) {
+    if (x.w.exactlyZero() && y.w.exactlyZero()) {
+      return {vCachedEdge::zero(), vCachedEdge::zero()};
+    }
+    auto xn = x;
+    auto yn = y;
+    if (const auto factor = normalizePair(xn, yn); !factor.exactlyOne()) {
+      const auto r = applySwapPair(xn, yn, level, gate);
+      return {scaleSuccessor(r[0], factor), scaleSuccessor(r[1], factor)};
+    }
+    if (const auto* r = vectorGatePairApplication.lookup(x, y); r != nullptr) {
+      return *r;
+    }
+
+    const auto var = static_cast<Qubit>(level - 1U);
+    std::array<vCachedEdge, RADIX> xs{getSuccessor(x, 0U), getSuccessor(x, 1U)};
+    std::array<vCachedEdge, RADIX> ys{getSuccessor(y, 0U), getSuccessor(y, 1U)};
+    if (var == gate.lowerTarget) {
+      const auto exchanged = applyGatePair(xs[1U], ys[0U], var, gate);
+      xs[1U] = exchanged[0U];
+      ys[0U] = exchanged[1U];
+    } else {
+      for (std::size_t i = 0U; i < RADIX; ++i) {
+        if (!gate.inactive(var, i)) {
+          const auto r = applySwapPair(xs[i], ys[i], var, gate);
+          xs[i] = r[0];
+          ys[i] = r[1];
+        }
+      }
+    }
+    const std::array r{makeDDNode(var, xs), makeDDNode(var, ys)};
+    vectorGatePairApplication.insert(x, y, r);
+    return r;
+  }
+
+public:
   dEdge applyOperationToDensity(dEdge& e, const mEdge& operation) {
     const auto tmp0 = conjugateTranspose(operation);
     const auto tmp1 = multiply(e, densityFromMatrixEdge(tmp0), false);
@@ -1800,6 +2372,132 @@ private:
     return e;
   }
 
+public:
+  /**
+   * @brief Multiply a matrix DD with a batch of vector DDs
+   * @details Computes the same products as calling multiply() for each vector,
+   * but traverses the matrix only once for the whole batch. On every level,
+   * the sub-matrices are combined with the corresponding successors of all
+   * vectors at once, where zero sub-matrices are skipped for the entire batch
+   * and vectors sharing a node (e.g., basis states that only differ in a few
+   * qubits) are multiplied only once. The products are cached in the same
+   * compute table as those of multiply(), so that batched and individual
+   * multiplications benefit from each other.
+   * @param x The matrix DD
+   * @param ys The vector DDs (defined over the same qubits)
+   * @return The products x·y for all y in @p ys (in the same order)
+   */
+  std::vector<vEdge> multiply(const mEdge& x, const std::vector<vEdge>& ys) {
+    Qubit var = x.isTerminal() ? 0U : x.p->v;
+    for (const auto& y : ys) {
+      if (!y.isTerminal() && y.p->v > var) {
+        var = y.p->v;
+      }
+    }
+    const auto products = multiplyBatch2(x, ys, var);
+    std::vector<vEdge> results{};
+    results.reserve(products.size());
+    for (const auto& product : products) {
+      results.emplace_back(cn.lookup(product));
+    }
+    return results;
+  }
+
+private:
+  std::vector<vCachedEdge> multiplyBatch2(const mEdge& x,
+                                          const std::vector<vEdge>& ys,
+                                          const Qubit var) {
+    std::vector<vCachedEdge> results(ys.size(), vCachedEdge::zero());
+    if (x.w.exactlyZero()) {
+      return results;
+    }
+
+    // the distinct vector nodes whose products are not known yet
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+    std::vector<vNode*> pending{};
+    std::vector<std::size_t> slot(ys.size(), none);
+    std::unordered_map<vNode*, std::size_t> index{};
+    const auto xWeight = static_cast<ComplexValue>(x.w);
+    auto& computeTable = getMultiplicationComputeTable<vNode>();
+    for (std::size_t b = 0U; b < ys.size(); ++b) {
+      const auto& y = ys[b];
+      if (y.w.exactlyZero()) {
+        continue;
+      }
+      const auto rWeight = xWeight * static_cast<ComplexValue>(y.w);
+      if (x.isIdentity()) {
+        results[b] = {y.p, rWeight};
+        continue;
+      }
+      if (const auto* r = computeTable.lookup(x.p, y.p, false); r != nullptr) {
+        results[b] = {r->p, r->w * rWeight};
+        continue;
+      }
+      const auto [it, inserted] = index.try_emplace(y.p, pending.size());
+      if (inserted) {
+        pending.emplace_back(y.p);
+      }
+      slot[b] = it->second;
+    }
+    if (pending.empty()) {
+      return results;
+    }
+
+    const auto v = static_cast<Qubit>(var - 1);
+    std::vector<std::array<vCachedEdge, RADIX>> edges(
+        pending.size(), {vCachedEdge::zero(), vCachedEdge::zero()});
+    std::vector<vEdge> operands(pending.size());
+    for (auto i = 0U; i < RADIX; i++) {
+      for (auto k = 0U; k < RADIX; k++) {
+        const auto xIdx = (RADIX * i) + k;
+        mEdge e1{};
+        if (x.p != nullptr && x.p->v == var) {
+          e1 = x.p->e[xIdx];
+        } else {
+          e1 = i == k ? mEdge{x.p, Complex::one()} : mEdge::zero();
+        }
+        // a zero sub-matrix contributes nothing to any of the products
+        if (e1.w.exactlyZero()) {
+          continue;
+        }
+
+        for (std::size_t u = 0U; u < pending.size(); ++u) {
+          const auto* p = pending[u];
+          if (p != nullptr && p->v == var) {
+            operands[u] = p->e[k];
+          } else {
+            operands[u] = k == 0U ? vEdge{pending[u], Complex::one()}
+                                  : vEdge::zero();
+          }
+        }
+        const auto products = multiplyBatch2(e1, operands, v);
+        for (std::size_t u = 0U; u < pending.size(); ++u) {
+          auto& edge = edges[u][i];
+          if (edge.w.exactlyZero()) {
+            edge = products[u];
+          } else if (!products[u].w.exactlyZero()) {
+            edge = add2(edge, products[u], v);
+          }
+        }
+      }
+    }
+
+    std::vector<vCachedEdge> nodes{};
+    nodes.reserve(pending.size());
+    for (std::size_t u = 0U; u < pending.size(); ++u) {
+      nodes.emplace_back(makeDDNode(var, edges[u]));
+      computeTable.insert(x.p, pending[u], nodes.back());
+    }
+    for (std::size_t b = 0U; b < ys.size(); ++b) {
+      if (slot[b] != none) {
+        const auto& node = nodes[slot[b]];
+        results[b] = {node.p, node.w * xWeight *
+                                  static_cast<ComplexValue>(ys[b].w)};
+      }
+    }
+    return results;
+  }
+
   ///
   /// Inner product, fidelity, expectation value
   ///
@@ -1986,15 +2684,19 @@ public:
           "Kronecker is currently not supported for density matrices");
     }
 
-    const auto e = kronecker2(x, y, yNumQubits, incIdx);
+    // the product of each node of x with y is computed only once per call,
+    // independent of collisions in the (small) compute table
+    std::unordered_map<const Node*, CachedEdge<Node>> memo{};
+    const auto e = kronecker2(x, y, yNumQubits, incIdx, memo);
     return cn.lookup(e);
   }
 
 private:
   template <class Node>
-  CachedEdge<Node> kronecker2(const Edge<Node>& x, const Edge<Node>& y,
-                              const std::size_t yNumQubits,
-                              const bool incIdx = true) {
+  CachedEdge<Node>
+  kronecker2(const Edge<Node>& x, const Edge<Node>& y,
+             const std::size_t yNumQubits, const bool incIdx,
+             std::unordered_map<const Node*, CachedEdge<Node>>& memo) {
     if (x.w.exactlyZero() || y.w.exactlyZero()) {
       return CachedEdge<Node>::zero();
     }
@@ -2029,15 +2731,19 @@ private:
     }
 
     // check if we already computed the product before and return the result
+    if (const auto it = memo.find(x.p); it != memo.end()) {
+      return {it->second.p, rWeight};
+    }
     auto& computeTable = getKroneckerComputeTable<Node>();
     if (const auto* r = computeTable.lookup(x.p, y.p); r != nullptr) {
+      memo.emplace(x.p, *r);
       return {r->p, rWeight};
     }
 
     constexpr std::size_t n = std::tuple_size_v<decltype(x.p->e)>;
     std::array<CachedEdge<Node>, n> edge{};
     for (auto i = 0U; i < n; ++i) {
-      edge[i] = kronecker2(x.p->e[i], y, yNumQubits, incIdx);
+      edge[i] = kronecker2(x.p->e[i], y, yNumQubits, incIdx, memo);
     }
 
     // Increase the qubit index
@@ -2057,6 +2763,7 @@ private:
     }
     auto e = makeDDNode(idx, edge, true);
     computeTable.insert(x.p, y.p, {e.p, e.w});
+    memo.emplace(x.p, e);
     return {e.p, rWeight};
   }
 
@@ -2077,8 +2784,17 @@ public:
     }
   }
 
+  /**
+   * @brief Compute the normalized partial trace of a matrix
+   * @details All qubits marked in @p eliminate are traced out in a single
+   * traversal of @p a and the remaining qubits are renumbered consecutively.
+   * @param a The matrix DD
+   * @param eliminate The qubits to trace out
+   * @return The reduced matrix divided by 2^k, where k is the number of
+   * eliminated qubits
+   */
   mEdge partialTrace(const mEdge& a, const std::vector<bool>& eliminate) {
-    auto r = trace(a, eliminate, eliminate.size());
+    auto r = trace(a, eliminate);
     return {r.p, cn.lookup(r.w)};
   }
 
@@ -2088,7 +2804,7 @@ public:
       return static_cast<ComplexValue>(a.w);
     }
     const auto eliminate = std::vector<bool>(numQubits, true);
-    return trace(a, eliminate, numQubits).w;
+    return trace(a, eliminate).w;
   }
 
   /**
@@ -2114,15 +2830,12 @@ public:
 
 private:
   /**
-   * @brief Computes the normalized (partial) trace using a compute table to
-   * store results for eliminated nodes.
-   * @details At each level, perform a lookup and store results in the compute
-   * table only if all lower-level qubits are eliminated as well.
-   *
-   * This optimization allows the full trace
-   * computation to scale linearly with respect to the number of nodes.
-   * However, the partial trace computation still scales with the number of
-   * paths to the lowest level in the DD that should be traced out.
+   * @brief Computes the normalized (partial) trace
+   * @details The results for the nodes of @p a are memoized for the duration
+   * of the call, so that every node is traced only once, even if the traced
+   * out qubits lie above non-eliminated ones. Results for nodes below which
+   * all qubits are eliminated do not depend on the remaining qubits and are
+   * additionally stored in the compute table to be reused across calls.
    *
    * For matrices, normalization is continuously applied, dividing by two at
    * each level marked for elimination, thereby ensuring that the result is
@@ -2133,8 +2846,21 @@ private:
    */
   template <class Node>
   CachedEdge<Node> trace(const Edge<Node>& a,
-                         const std::vector<bool>& eliminate, std::size_t level,
-                         std::size_t alreadyEliminated = 0) {
+                         const std::vector<bool>& eliminate) {
+    // eliminatedBelow[v] is the number of eliminated qubits with index < v
+    std::vector<std::size_t> eliminatedBelow(eliminate.size() + 1U, 0U);
+    for (std::size_t v = 0U; v < eliminate.size(); ++v) {
+      eliminatedBelow[v + 1U] = eliminatedBelow[v] + (eliminate[v] ? 1U : 0U);
+    }
+    std::unordered_map<const Node*, CachedEdge<Node>> memo{};
+    return traceRecursive(a, eliminate, eliminatedBelow, memo);
+  }
+
+  template <class Node>
+  CachedEdge<Node>
+  traceRecursive(const Edge<Node>& a, const std::vector<bool>& eliminate,
+                 const std::vector<std::size_t>& eliminatedBelow,
+                 std::unordered_map<const Node*, CachedEdge<Node>>& memo) {
     const auto aWeight = static_cast<ComplexValue>(a.w);
     if (aWeight.approximatelyZero()) {
       return CachedEdge<Node>::zero();
@@ -2142,62 +2868,63 @@ private:
 
     // If `a` is the identity matrix or there is nothing left to eliminate,
     // then simply return `a`
-    if (a.isIdentity() ||
-        std::none_of(eliminate.begin(),
-                     eliminate.begin() +
-                         static_cast<std::vector<bool>::difference_type>(level),
-                     [](bool v) { return v; })) {
+    if (a.isIdentity()) {
+      return CachedEdge<Node>{a.p, aWeight};
+    }
+    const auto v = static_cast<std::size_t>(a.p->v);
+    const auto eliminateHere = v < eliminate.size() && eliminate[v];
+    const auto below = eliminatedBelow[std::min(v, eliminate.size())];
+    if (!eliminateHere && below == 0U) {
       return CachedEdge<Node>{a.p, aWeight};
     }
 
-    const auto v = a.p->v;
-    if (eliminate[v]) {
-      // Lookup nodes marked for elimination in the compute table if all
-      // lower-level qubits are eliminated as well: if the trace has already
-      // been computed, return the result
-      const auto eliminateAll = std::all_of(
-          eliminate.begin(),
-          eliminate.begin() +
-              static_cast<std::vector<bool>::difference_type>(level),
-          [](bool e) { return e; });
-      if (eliminateAll) {
-        if (const auto* r = getTraceComputeTable<Node>().lookup(a.p);
-            r != nullptr) {
-          return {r->p, r->w * aWeight};
-        }
+    if (const auto it = memo.find(a.p); it != memo.end()) {
+      return {it->second.p, it->second.w * aWeight};
+    }
+    // the trace of nodes below which all qubits are eliminated is a scalar
+    const auto eliminateAll = eliminateHere && below == v;
+    if (eliminateAll) {
+      if (const auto* r = getTraceComputeTable<Node>().lookup(a.p);
+          r != nullptr) {
+        memo.emplace(a.p, *r);
+        return {r->p, r->w * aWeight};
       }
+    }
 
-      const auto elims = alreadyEliminated + 1;
-      auto r = add2(trace(a.p->e[0], eliminate, level - 1, elims),
-                    trace(a.p->e[3], eliminate, level - 1, elims), v - 1);
+    CachedEdge<Node> r{};
+    if (eliminateHere) {
+      const auto e0 = traceRecursive(a.p->e[0], eliminate, eliminatedBelow,
+                                     memo);
+      const auto e3 = traceRecursive(a.p->e[3], eliminate, eliminatedBelow,
+                                     memo);
+      // both results are defined on the remaining qubits below this level
+      Qubit var = 0U;
+      for (const auto* p : {e0.p, e3.p}) {
+        if (p != nullptr && p->v > var) {
+          var = p->v;
+        }
+      }
+      r = add2(e0, e3, var);
 
       // The resulting weight is continuously normalized to the range [0,1] for
       // matrix nodes
       if constexpr (std::is_same_v<Node, mNode>) {
         r.w = r.w / 2.0;
       }
-
-      // Insert result into compute table if all lower-level qubits are
-      // eliminated as well
-      if (eliminateAll) {
-        getTraceComputeTable<Node>().insert(a.p, r);
-      }
-      r.w = r.w * aWeight;
-      return r;
+    } else {
+      std::array<CachedEdge<Node>, NEDGE> edge{};
+      std::transform(a.p->e.cbegin(), a.p->e.cend(), edge.begin(),
+                     [&](const Edge<Node>& e) -> CachedEdge<Node> {
+                       return traceRecursive(e, eliminate, eliminatedBelow,
+                                             memo);
+                     });
+      r = makeDDNode(static_cast<Qubit>(v - below), edge);
     }
 
-    std::array<CachedEdge<Node>, NEDGE> edge{};
-    std::transform(a.p->e.cbegin(), a.p->e.cend(), edge.begin(),
-                   [this, &eliminate, &alreadyEliminated,
-                    &level](const Edge<Node>& e) -> CachedEdge<Node> {
-                     return trace(e, eliminate, level - 1, alreadyEliminated);
-                   });
-    const auto adjustedV =
-        static_cast<Qubit>(static_cast<std::size_t>(a.p->v) -
-                           (static_cast<std::size_t>(std::count(
-                                eliminate.begin(), eliminate.end(), true)) -
-                            alreadyEliminated));
-    auto r = makeDDNode(adjustedV, edge);
+    if (eliminateAll) {
+      getTraceComputeTable<Node>().insert(a.p, r);
+    }
+    memo.emplace(a.p, r);
     r.w = r.w * aWeight;
     return r;
   }
@@ -2289,6 +3016,17 @@ public:
     return reduceAncillae(e, ancillary);
   }
 
+  ///
+  /// Operation DD caching
+  ///
+  OperationTable<mEdge, Config::CT_OPERATION_NBUCKET> operationTable{};
+
+  /// Release the references held by the operation table and clear it
+  void clearOperationTable() {
+    operationTable.forEach([this](const mEdge& e) { decRef(e); });
+    operationTable.clear();
+  }
+
   ///
   /// Noise Operations
   ///
@@ -2685,7 +3423,7 @@ public:
 
     // POST ORDER TRAVERSAL USING ONE STACK
     // https://www.geeksforgeeks.org/iterative-postorder-traversal-using-stack/
-    Edge<Node> root{};
+    CachedEdge<Node> root{};
     std::stack<Edge<Node>*> stack;
 
     std::unordered_map<decltype(original.p), decltype(original.p)> mappedNode{};
@@ -2738,22 +3476,22 @@ public:
           currentEdge = nullptr;
           continue;
         }
-        std::array<Edge<Node>, n> edges{};
+        // the weights are only looked up once the new node is normalized
+        std::array<CachedEdge<Node>, n> edges{};
         for (std::size_t i = 0; i < n; i++) {
           if (currentEdge->p->e[i].isTerminal()) {
             edges[i].p = currentEdge->p->e[i].p;
           } else {
             edges[i].p = mappedNode[currentEdge->p->e[i].p];
           }
-          edges[i].w = cn.lookup(currentEdge->p->e[i].w);
+          edges[i].w = static_cast<ComplexValue>(currentEdge->p->e[i].w);
         }
         root = makeDDNode(currentEdge->p->v, edges);
         mappedNode[currentEdge->p] = root.p;
         currentEdge = nullptr;
       }
     } while (!stack.empty());
-    root.w = cn.lookup(original.w * root.w);
-    return root;
+    return {root.p, cn.lookup(original.w * root.w)};
   }
 
   ///
@@ -2916,5 +3654,6 @@ private:
 };
 
 using UnitarySimulatorDDPackage = Package<UnitarySimulatorDDPackageConfig>;
+using CliffordTDDPackage = Package<CliffordTDDPackageConfig>;
 
 } // namespace dd
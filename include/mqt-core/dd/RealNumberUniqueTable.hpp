@@ -10,6 +10,7 @@
 #pragma once
 
 #include "dd/DDDefinitions.hpp"
+#include "dd/ExactRealNumber.hpp"
 #include "dd/MemoryManager.hpp"
 #include "dd/statistics/UniqueTableStatistics.hpp"
 
@@ -17,6 +18,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <vector>
 
 namespace dd {
 
@@ -26,7 +28,10 @@ struct RealNumber;
  * @brief A unique table for real numbers.
  * @details A hash table that stores real numbers. The hash table is implemented
  * as an array of buckets, each of which is a linked list of entries. The hash
- * table has a fixed number of buckets.
+ * table has a fixed number of buckets. The values of the first few entries of
+ * each bucket are additionally kept in a contiguous, cache-line sized block so
+ * that most lookups can be answered by a single (vectorized) comparison
+ * against all of them instead of walking the list.
  * @note: The implementation assumes that all values are non-negative and in the
  * range [0, 1]. While numbers outside of this range can be stored, they will
  * always be placed in the same bucket and will therefore cause collisions.
@@ -51,6 +56,14 @@ class RealNumberUniqueTable {
    */
   static constexpr std::size_t INITIAL_GC_LIMIT = 65536U;
 
+  /**
+   * @brief The number of entries per bucket that are stored inline.
+   * @details Buckets typically hold only a handful of entries. Four double
+   * values fill exactly one AVX register and, together with the corresponding
+   * pointers, one cache line.
+   */
+  static constexpr std::size_t INLINE_BUCKET_SIZE = 4U;
+
 public:
   /**
    * @brief The default constructor
@@ -79,6 +92,31 @@ public:
   /// Get a reference to the statistics
   [[nodiscard]] const auto& getStats() const noexcept { return stats; }
 
+  /**
+   * @brief Enable or disable exact lookups
+   * @details If enabled, every number that is newly inserted into the table is
+   * checked for whether it is (up to rounding errors) an element of Q(√2),
+   * which covers all weights arising in Clifford+T circuits. Such numbers are
+   * stored with their exact value (rounded once) and are additionally
+   * registered in an exact table keyed by their algebraic representation.
+   * Consequently, numbers that are mathematically equal are always mapped to
+   * the same entry, even if rounding errors accumulated beyond the tolerance.
+   * Numbers that are not recognized are handled as before.
+   * @param enable Whether to enable exact lookups.
+   * @see RationalSqrt2
+   */
+  void setExactLookups(const bool enable) noexcept { exactLookups = enable; }
+
+  /// Whether exact lookups are enabled
+  [[nodiscard]] bool exactLookupsEnabled() const noexcept {
+    return exactLookups;
+  }
+
+  /// Get a reference to the table of exactly represented numbers.
+  [[nodiscard]] const auto& getExactTable() const noexcept {
+    return exactTable;
+  }
+
   /**
    * @brief Lookup a number in the table
    * @details This function is used to lookup and insert them into the table if
@@ -175,12 +213,49 @@ private:
    */
   std::array<RealNumber*, NBUCKET> tailTable{};
 
+  /**
+   * @brief A contiguous copy of the first entries of a bucket
+   * @details Mirrors the first INLINE_BUCKET_SIZE entries of the (sorted)
+   * bucket list. Unused slots hold a value that never matches any lookup and
+   * a nullptr. The list remains the authoritative storage; entries beyond the
+   * inline ones (the overflow chain) are only reachable via the list.
+   */
+  struct alignas(64) InlineBucket {
+    std::array<fp, INLINE_BUCKET_SIZE> values;
+    std::array<RealNumber*, INLINE_BUCKET_SIZE> entries;
+
+    /**
+     * @brief Search the inline values for the one closest to val.
+     * @param val The value to search for.
+     * @returns The index of the closest value within tolerance of val or
+     * INLINE_BUCKET_SIZE if there is none.
+     */
+    [[nodiscard]] std::size_t find(fp val) const noexcept;
+
+    /// Whether the bucket holds more entries than are stored inline.
+    [[nodiscard]] bool overflows() const noexcept;
+
+    /// Reset the block to represent an empty bucket.
+    void reset() noexcept;
+  };
+  /**
+   * @brief The inline blocks of all buckets
+   * @details Kept on the heap since it is considerably larger than the tables
+   * above and packages are frequently created on the stack.
+   */
+  std::vector<InlineBucket> inlineTable;
+
   /// A pointer to the memory manager for the numbers stored in the table.
   MemoryManager<RealNumber>* memoryManager{};
 
   /// A collection of statistics
   UniqueTableStatistics stats{};
 
+  /// Whether exact lookups are enabled
+  bool exactLookups = false;
+  /// The numbers that are represented exactly (if exact lookups are enabled)
+  ExactRealNumberTable exactTable{};
+
   /// The initial garbage collection limit
   std::size_t initialGCLimit;
   /// The current garbage collection limit
@@ -197,6 +272,22 @@ private:
    */
   RealNumber* findOrInsert(std::int64_t key, fp val);
 
+  /**
+   * @brief Finds or inserts a value by walking the bucket indexed by key.
+   * @details Slow path of findOrInsert that is taken whenever the inline block
+   * of the bucket does not suffice to answer the lookup.
+   * @param key The index of the bucket to find or insert the value into.
+   * @param val The value to find or insert.
+   * @returns A pointer to the found or inserted entry.
+   */
+  RealNumber* findOrInsertInList(std::int64_t key, fp val);
+
+  /**
+   * @brief Update the inline block of a bucket from its list.
+   * @param key The index of the bucket.
+   */
+  void refreshInlineBucket(std::size_t key) noexcept;
+
   /**
    * @brief Inserts a value in the front of the bucket indexed by key.
    * @param key The index of the bucket to insert the value into.
@@ -223,5 +314,29 @@ private:
    * @returns An aligned pointer to the entry corresponding to the number.
    */
   [[nodiscard]] RealNumber* lookupNonNegative(fp val);
+
+  /**
+   * @brief Lookup a non-negative number in the table up to tolerance.
+   * @details Implements lookupNonNegative without exact lookups.
+   * @param val The floating point number to look up. Must be non-negative.
+   * @returns An aligned pointer to the entry corresponding to the number.
+   */
+  [[nodiscard]] RealNumber* lookupApproximately(fp val);
+
+  /**
+   * @brief Replace a newly inserted entry by its exact counterpart.
+   * @details If the value of the entry is recognized as an element of Q(√2),
+   * the entry is removed again and the entry for the exact number is
+   * returned instead (inserting it if necessary).
+   * @param entry The newly inserted entry.
+   * @returns The entry to use in place of the given one.
+   */
+  [[nodiscard]] RealNumber* snapToExact(RealNumber* entry);
+
+  /**
+   * @brief Remove an unreferenced entry from its bucket.
+   * @param entry The entry to remove.
+   */
+  void remove(RealNumber* entry) noexcept;
 };
 } // namespace dd
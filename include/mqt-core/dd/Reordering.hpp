@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/Edge.hpp"
+#include "dd/Package_fwd.hpp"
+#include "ir/Permutation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dd {
+
+/// Heuristic used to search for a better variable order
+enum class ReorderingMethod : std::uint8_t {
+  /// never reorder
+  None,
+  /// move each qubit through all levels and keep the best position (Rudell)
+  Sifting,
+  /// try all arrangements of every window of three adjacent levels
+  Window
+};
+
+/**
+ * @brief Strategy for reordering the qubits of a DD
+ * @details If @p staticOrder is set, the computation starts from the order
+ * proposed by proposeQubitOrder() (see StaticOrdering.hpp) instead of the
+ * initial layout. The size of the DD is checked every @p checkInterval
+ * operations. Whenever it exceeds @p threshold nodes, the qubit order is
+ * improved with the given @p method. Afterwards, the threshold is raised to
+ * `thresholdGrowth` times the size of the reordered DD (if that is larger), so
+ * that a DD that cannot be reduced any further does not trigger a reordering
+ * at every check.
+ */
+struct DynamicReordering {
+  /// Whether to start from an order derived from the circuit structure
+  bool staticOrder = false;
+  /// The heuristic used for reordering
+  ReorderingMethod method = ReorderingMethod::Sifting;
+  /// The number of nodes that triggers a reordering (0 disables reordering)
+  std::size_t threshold = 0U;
+  /// The factor by which the threshold is raised after a reordering
+  fp thresholdGrowth = 2.;
+  /// The number of operations between two checks of the DD size
+  std::size_t checkInterval = 8U;
+  /// Sifting stops moving a qubit in one direction once the DD is larger
+  /// than this factor times the smallest size seen so far
+  fp maxGrowth = 1.2;
+
+  /// Whether the DD is reordered once it exceeds the threshold
+  [[nodiscard]] bool dynamicEnabled() const noexcept {
+    return method != ReorderingMethod::None && threshold != 0U;
+  }
+
+  /// Whether the DD size is checked after the given number of operations
+  [[nodiscard]] bool checkDue(const std::size_t operations) const noexcept {
+    return checkInterval <= 1U || operations % checkInterval == 0U;
+  }
+
+  [[nodiscard]] bool enabled() const noexcept {
+    return staticOrder || dynamicEnabled();
+  }
+};
+
+/**
+ * @brief Information collected over the reordering rounds of a computation
+ */
+struct ReorderingMetadata {
+  /// Number of reordering rounds
+  std::size_t rounds = 0U;
+  /// Total number of adjacent level swaps
+  std::size_t swaps = 0U;
+  /// Total number of nodes saved over all rounds
+  std::size_t removedNodes = 0U;
+};
+
+/**
+ * @brief Exchange two adjacent levels of a DD
+ * @details Only the nodes at or above level @p level + 1 are rebuilt, where
+ * the four (vectors) or sixteen (matrices) sub-DDs below the two levels are
+ * recombined in exchanged order. Hence, the result represents the same
+ * function with the qubits @p level and @p level + 1 exchanged, i.e., the
+ * state SWAP|ψ> or the matrix SWAP·U·SWAP. Since nodes keep their meaning,
+ * all compute tables remain valid.
+ * @param e The DD whose levels are exchanged
+ * @param level The lower of the two levels
+ * @param dd The DD package
+ * @return The resulting DD. Reference counts are not modified.
+ */
+template <class Node, class Config>
+Edge<Node> swapAdjacentLevels(const Edge<Node>& e, Qubit level,
+                              Package<Config>& dd);
+
+/**
+ * @brief Improve the qubit order of a DD by sifting
+ * @details Qubits are processed in order of decreasing number of nodes on
+ * their level. Each qubit is first moved towards the closer end of the order
+ * and then towards the other one by adjacent level swaps, stopping early in a
+ * direction once the DD grows beyond `maxGrowth` times the best size seen so
+ * far. Afterwards, the qubit is moved back to the best position. Only the
+ * levels `0, ..., k - 1` are reordered, where k is the smallest level that is
+ * not covered by the values of @p permutation. The reference count of @p e is
+ * transferred to the reordered DD.
+ * @param e The DD to reorder. Replaced by the reordered DD.
+ * @param permutation The mapping from qubits to levels. The values are
+ * updated to follow the moved levels.
+ * @param dd The DD package
+ * @param metadata Statistics that are updated with this reordering
+ * @param maxGrowth The maximal intermediate growth of the DD
+ * @return The size of the reordered DD
+ */
+template <class Node, class Config>
+std::size_t sift(Edge<Node>& e, qc::Permutation& permutation,
+                 Package<Config>& dd, ReorderingMetadata& metadata,
+                 fp maxGrowth = 1.2);
+
+/**
+ * @brief Improve the qubit order of a DD by window permutation
+ * @details All six arrangements of each window of three adjacent levels are
+ * enumerated by five adjacent level swaps and the best one is kept. Windows
+ * are swept from the bottom to the top until no window improves the size.
+ * The same restrictions and conventions as for sift() apply.
+ * @return The size of the reordered DD
+ */
+template <class Node, class Config>
+std::size_t windowPermutation(Edge<Node>& e, qc::Permutation& permutation,
+                              Package<Config>& dd,
+                              ReorderingMetadata& metadata);
+
+/**
+ * @brief Reorder a DD with the method of @p strategy
+ * @details Dispatches to sift() or windowPermutation() and records the round
+ * in @p metadata.
+ * @return The size of the reordered DD
+ */
+template <class Node, class Config>
+std::size_t reorder(Edge<Node>& e, qc::Permutation& permutation,
+                    Package<Config>& dd, const DynamicReordering& strategy,
+                    ReorderingMetadata& metadata);
+
+} // namespace dd
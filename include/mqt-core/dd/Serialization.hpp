@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/Edge.hpp"
+#include "dd/Package_fwd.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace dd {
+
+///
+/// Compact binary serialization
+/// Note: the format uses the byte order of the host and is not meant to be
+/// portable across different architectures/platforms
+///
+
+/// Version of the compact binary serialization format
+static constexpr std::uint32_t COMPACT_SERIALIZATION_VERSION = 1U;
+
+/// Magic bytes at the beginning of every compact serialization
+static constexpr std::array<char, 8> COMPACT_SERIALIZATION_MAGIC = {
+    'M', 'Q', 'T', 'D', 'D', 'B', 'I', 'N'};
+
+/**
+ * @brief Header of the compact binary serialization format
+ * @details The header is followed by the payload, which consists of the
+ * following sections (in this order):
+ * - the number of nodes per level (`std::uint64_t[numLevels]`, level 0 first),
+ * - the deduplicated weight table (pairs of `fp`; index 0 is zero, index 1 is
+ *   one),
+ * - the sizes of the following two columns in bytes (`std::uint64_t` each),
+ * - the successor column (`RADIX` entries per node; 0 refers to the terminal,
+ *   `k + 1` to the `k`-th node),
+ * - the weight column (`RADIX` indices into the weight table per node).
+ *
+ * Nodes are stored in level order, starting with the lowest level. Hence, all
+ * successors of a node precede it in the node table, which allows to load the
+ * DD in a single pass without recursion. The columns are either stored as
+ * `std::uint32_t` or, if the `Compressed` flag is set, as LEB128 varints with
+ * successors encoded relative to the index of the node they belong to. The
+ * checksum is the 64-bit FNV-1a hash of the payload.
+ */
+struct CompactSerializationHeader {
+  enum Flags : std::uint32_t { Compressed = 1U };
+
+  std::array<char, 8> magic = COMPACT_SERIALIZATION_MAGIC;
+  std::uint32_t version = COMPACT_SERIALIZATION_VERSION;
+  /// Number of successors per node (2 for vectors, 4 for matrices)
+  std::uint32_t radix = 0U;
+  std::uint32_t flags = 0U;
+  std::uint32_t numLevels = 0U;
+  std::uint64_t numNodes = 0U;
+  std::uint64_t numWeights = 0U;
+  /// Index of the root node (0 if the DD is a terminal)
+  std::uint64_t root = 0U;
+  /// Index of the root weight in the weight table
+  std::uint64_t rootWeight = 0U;
+  /// Size of the payload following the header in bytes
+  std::uint64_t payloadSize = 0U;
+  std::uint64_t checksum = 0U;
+};
+
+/**
+ * @brief Serialize a DD in the compact binary format
+ * @param e The DD to serialize
+ * @param os The stream to write to
+ * @param compress Whether to varint-encode the node table
+ */
+template <class Node>
+void serializeCompact(const Edge<Node>& e, std::ostream& os,
+                      bool compress = false);
+
+/// @see serializeCompact(const Edge<Node>&, std::ostream&, bool)
+template <class Node>
+void serializeCompact(const Edge<Node>& e, const std::string& outputFilename,
+                      bool compress = false);
+
+/**
+ * @brief Load a DD from a buffer holding its compact binary serialization
+ * @details The header, the version, and the checksum are validated before any
+ * node is created. All distinct weights are looked up once, and the nodes are
+ * directly inserted into the unique tables of @p dd level by level (skipping
+ * the normalization performed by makeDDNode, since serialized DDs are already
+ * normalized).
+ * @param data Pointer to the serialized data
+ * @param size Size of the serialized data in bytes
+ * @param dd The DD package to load the DD into
+ * @return The loaded DD. Its reference count is not increased.
+ * @throws std::runtime_error if the data is not a valid serialization
+ */
+template <class Node, class Config>
+Edge<Node> deserializeCompact(const char* data, std::size_t size,
+                              Package<Config>& dd);
+
+/// @see deserializeCompact(const char*, std::size_t, Package<Config>&)
+template <class Node, class Config>
+Edge<Node> deserializeCompact(std::istream& is, Package<Config>& dd);
+
+/**
+ * @brief Load a DD from a file holding its compact binary serialization
+ * @details On POSIX systems, the file is memory-mapped instead of being read
+ * into an intermediate buffer.
+ * @see deserializeCompact(const char*, std::size_t, Package<Config>&)
+ */
+template <class Node, class Config>
+Edge<Node> deserializeCompact(const std::string& inputFilename,
+                              Package<Config>& dd);
+
+} // namespace dd
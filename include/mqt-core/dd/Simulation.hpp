@@ -9,44 +9,284 @@
 
 #pragma once
 
+#include "dd/Approximation.hpp"
+#include "dd/Checkpoint.hpp"
 #include "dd/DDDefinitions.hpp"
+#include "dd/Node.hpp"
 #include "dd/Operations.hpp"
 #include "dd/Package_fwd.hpp"
+#include "dd/Reordering.hpp"
+#include "dd/StaticOrdering.hpp"
+#include "dd/statistics/Tracer.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/OpType.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace dd {
 using namespace qc;
 
+/**
+ * @brief Apply a unitary operation to a batch of vector DDs
+ * @details Operations that are not applied directly (see isAppliedDirectly())
+ * are turned into a DD once, which is multiplied with all states at once (see
+ * Package::multiply(const mEdge&, const std::vector<vEdge>&)). An attached
+ * tracer records a single event for the batch, whose DD size is the total
+ * size of the resulting states. Direct operations are applied to each state
+ * in turn (see applyUnitaryOperation()). Since their compute tables still hold
+ * the results of the operation when it is applied to the next state, states
+ * sharing sub-DDs share their computations. An attached size profiler records
+ * a single sample for the whole batch, such that the samples still correspond
+ * to operations. The references of the states are transferred to the results.
+ */
 template <class Config>
-VectorDD simulate(const QuantumComputation* qc, const VectorDD& in,
-                  Package<Config>& dd) {
-  auto permutation = qc->initialLayout;
-  auto e = in;
-  for (const auto& op : *qc) {
-    // SWAP gates can be executed virtually by changing the permutation
+void applyUnitaryOperation(const Operation* op, std::vector<VectorDD>& states,
+                           Package<Config>& dd,
+                           const Permutation& permutation = {}) {
+  if (!isAppliedDirectly(op)) {
+    auto* const tracer = dd.getTracer();
+    typename Package<Config>::TraceSnapshot snapshot{};
+    if (tracer != nullptr) {
+      snapshot = dd.traceBegin();
+    }
+    const auto results = dd.multiply(getDD(op, dd, permutation), states);
+    for (std::size_t i = 0U; i < states.size(); ++i) {
+      dd.incRef(results[i]);
+      dd.decRef(states[i]);
+      states[i] = results[i];
+    }
+    dd.garbageCollect();
+    if (tracer != nullptr) {
+      TraceEvent event{};
+      event.name = op->getName();
+      auto& recorded = dd.traceEnd(snapshot, std::move(event));
+      for (const auto& e : states) {
+        recorded.ddSize += e.size();
+      }
+    }
+    dd.template recordSize<vNode>(op->getName());
+    return;
+  }
+
+  auto* const profiler = dd.getSizeProfiler();
+  dd.setSizeProfiler(nullptr);
+  try {
+    for (auto& e : states) {
+      e = applyUnitaryOperation(op, e, dd, permutation);
+    }
+  } catch (...) {
+    dd.setSizeProfiler(profiler);
+    throw;
+  }
+  dd.setSizeProfiler(profiler);
+  dd.template recordSize<vNode>(op->getName());
+}
+
+/**
+ * @brief Simulate the operations of a circuit starting at index @p first
+ * @details This is the common loop of all simulation variants. Uncontrolled
+ * SWAP gates are executed virtually by updating @p permutation (and recorded
+ * by an attached size profiler). All other operations are applied to every
+ * state in @p states (see applyUnitaryOperation()), which transfers the
+ * references of the states to the results. After each operation,
+ * @p afterOperation is called with the index of the operation, e.g., to bound
+ * the size of the states.
+ * @param qc The quantum computation to simulate
+ * @param first The index of the first operation to simulate
+ * @param states The current states. Replaced by the resulting states.
+ * @param permutation The current permutation. Updated by SWAP gates.
+ * @param dd The DD package
+ * @param afterOperation Called after each operation
+ * @param skipNonUnitary Whether non-unitary operations are skipped (instead of
+ * being rejected by applyUnitaryOperation())
+ */
+template <class Config, class Callback>
+void simulateOperations(const QuantumComputation& qc, const std::size_t first,
+                        std::vector<VectorDD>& states, Permutation& permutation,
+                        Package<Config>& dd, Callback&& afterOperation,
+                        const bool skipNonUnitary = false) {
+  for (auto i = first; i < qc.getNops(); ++i) {
+    const auto* op = qc.at(i).get();
     if (op->getType() == OpType::SWAP && !op->isControlled()) {
       const auto& targets = op->getTargets();
       std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
-      continue;
+      dd.template recordSize<vNode>(op->getName());
+    } else if (!skipNonUnitary || op->isUnitary()) {
+      if (states.size() == 1U) {
+        states.front() =
+            applyUnitaryOperation(op, states.front(), dd, permutation);
+      } else {
+        applyUnitaryOperation(op, states, dd, permutation);
+      }
     }
+    afterOperation(i);
+  }
+}
 
-    e = applyUnitaryOperation(op.get(), e, dd, permutation);
+template <class Config>
+VectorDD simulate(const QuantumComputation* qc, const VectorDD& in,
+                  Package<Config>& dd) {
+  auto permutation = qc->initialLayout;
+  std::vector states{in};
+  simulateOperations(*qc, 0U, states, permutation, dd, [](std::size_t) {});
+  auto e = states.front();
+  changePermutation(e, permutation, qc->outputPermutation, dd);
+  e = dd.reduceGarbage(e, qc->garbage);
+  return e;
+}
+
+/**
+ * @brief Simulate a quantum computation for a batch of initial states
+ * @details Works like the regular simulation, but every operation is applied
+ * to all states before the next operation is considered. Hence, states
+ * sharing sub-DDs share their computations, since the compute tables
+ * (including those of direct gate application, see Package::applyGate())
+ * still hold the results of the operation when it is applied to the next
+ * state. An attached size profiler records one sample per operation.
+ * @param qc The quantum computation to simulate
+ * @param in The initial states. Their references are transferred to the final
+ * states.
+ * @param dd The DD package
+ * @return The final states (in the same order as the initial states)
+ */
+template <class Config>
+std::vector<VectorDD> simulate(const QuantumComputation* qc,
+                               const std::vector<VectorDD>& in,
+                               Package<Config>& dd) {
+  auto permutation = qc->initialLayout;
+  auto states = in;
+  simulateOperations(*qc, 0U, states, permutation, dd, [](std::size_t) {});
+  for (auto& e : states) {
+    auto from = permutation;
+    changePermutation(e, from, qc->outputPermutation, dd);
+    e = dd.reduceGarbage(e, qc->garbage);
   }
+  return states;
+}
+
+/**
+ * @brief Simulate a quantum computation with a bounded state DD size
+ * @details Works like the regular simulation, but after each operation the
+ * size of the state DD is checked against the node budget of @p strategy. If
+ * the budget is exceeded, the state is approximated by removing the nodes that
+ * contribute least to the state and renormalizing it (see approximate()).
+ * @param qc The quantum computation to simulate
+ * @param in The initial state
+ * @param dd The DD package
+ * @param strategy The approximation strategy
+ * @param metadata Collects the accumulated fidelity loss of the approximation
+ * @return The (approximated) final state
+ */
+template <class Config>
+VectorDD simulate(const QuantumComputation* qc, const VectorDD& in,
+                  Package<Config>& dd, const NodeBudgetApproximation& strategy,
+                  ApproximationMetadata& metadata) {
+  if (!strategy.enabled()) {
+    return simulate(qc, in, dd);
+  }
+  const auto budget = std::max<std::size_t>(
+      1U, static_cast<std::size_t>(static_cast<fp>(strategy.maxNodes) *
+                                   strategy.targetRatio));
+
+  auto permutation = qc->initialLayout;
+  std::vector states{in};
+  simulateOperations(*qc, 0U, states, permutation, dd, [&](std::size_t) {
+    if (dd.exceedsSize(states.front(), strategy.maxNodes)) {
+      approximate(states.front(), budget, dd, metadata);
+    }
+  });
+  auto e = states.front();
   changePermutation(e, permutation, qc->outputPermutation, dd);
   e = dd.reduceGarbage(e, qc->garbage);
   return e;
 }
 
+/**
+ * @brief Simulate a quantum computation with qubit reordering
+ * @details Works like the regular simulation, but the qubits of the initial
+ * state are first moved to the order proposed by proposeQubitOrder() if
+ * `strategy.staticOrder` is set. Moreover, every `strategy.checkInterval`
+ * operations the size of the state DD is checked against the current
+ * threshold of @p strategy. If it is exceeded, the qubit order of the state
+ * is improved (see reorder()) and the threshold is raised accordingly. The
+ * permutation tracks the level of every qubit, so subsequent operations act on
+ * the correct levels and the final state is restored to the output
+ * permutation.
+ * @param qc The quantum computation to simulate
+ * @param in The initial state
+ * @param dd The DD package
+ * @param strategy The reordering strategy
+ * @param metadata Collects statistics of the reordering rounds
+ * @return The final state
+ */
+template <class Config>
+VectorDD simulate(const QuantumComputation* qc, const VectorDD& in,
+                  Package<Config>& dd, const DynamicReordering& strategy,
+                  ReorderingMetadata& metadata) {
+  if (!strategy.enabled()) {
+    return simulate(qc, in, dd);
+  }
+
+  auto threshold = strategy.threshold;
+  auto permutation = qc->initialLayout;
+  std::vector states{in};
+  if (strategy.staticOrder) {
+    // move the qubits of the initial state to their proposed levels
+    changePermutation(states.front(), permutation, proposeQubitOrder(*qc), dd);
+  }
+  simulateOperations(*qc, 0U, states, permutation, dd, [&](std::size_t i) {
+    if (strategy.dynamicEnabled() && strategy.checkDue(i + 1U) &&
+        dd.exceedsSize(states.front(), threshold)) {
+      const auto size =
+          reorder(states.front(), permutation, dd, strategy, metadata);
+      threshold = std::max(threshold,
+                           static_cast<std::size_t>(static_cast<fp>(size) *
+                                                    strategy.thresholdGrowth));
+    }
+  });
+  auto e = states.front();
+  changePermutation(e, permutation, qc->outputPermutation, dd);
+  e = dd.reduceGarbage(e, qc->garbage);
+  return e;
+}
+
+/**
+ * @brief Simulate a quantum computation with periodic checkpoints
+ * @details Works like the regular simulation, but every
+ * `checkpointing.interval` operations the current state, permutation, and
+ * operation index are written to `checkpointing.filename` (see
+ * saveCheckpoint()). If `checkpointing.resume` is set and the file exists, the
+ * simulation continues from the stored checkpoint instead of @p in (whose
+ * reference is released in that case). Non-unitary operations are skipped.
+ * @param qc The quantum computation to simulate
+ * @param in The initial state
+ * @param dd The DD package
+ * @param checkpointing The checkpoint configuration
+ * @return The final state
+ * @throws std::invalid_argument if the checkpoint to resume from belongs to a
+ * different circuit (see circuitFingerprint())
+ */
+template <class Config>
+VectorDD simulate(const QuantumComputation* qc, const VectorDD& in,
+                  Package<Config>& dd, const CheckpointOptions& checkpointing);
+
+/**
+ * @brief Sample from the output distribution of a quantum computation
+ * @details If the circuit only contains measurements at the end, it is
+ * simulated once (with checkpoints according to @p checkpointing, including
+ * the state of the random number generator) and sampled @p shots times.
+ * Dynamic circuits are simulated shot by shot without checkpoints.
+ */
 template <class Config>
 std::map<std::string, std::size_t>
 sample(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
-       std::size_t shots, std::size_t seed = 0U);
+       std::size_t shots, std::size_t seed = 0U,
+       const CheckpointOptions& checkpointing = {});
 
 /**
  * Sample from the output distribution of a quantum computation
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+#include "ir/Permutation.hpp"
+#include "ir/QuantumComputation.hpp"
+
+namespace dd {
+
+/**
+ * @brief Estimate the size of the DDs arising from a circuit under a qubit
+ * order
+ * @details Every multi-qubit gate may increase the entanglement across each
+ * cut between adjacent levels that separates its qubits. The entanglement
+ * across a cut is estimated by the number of such gates, bounded by the number
+ * of qubits on either side of the cut that interact across it. Since a DD has
+ * at most 2^e nodes directly below a cut with entanglement e, the estimate is
+ * the sum of 2^e over all cuts. Uncontrolled SWAP gates are executed
+ * virtually by the simulation and, hence, only relabel the qubits.
+ * @param qc The quantum computation
+ * @param order The mapping from the qubits of @p qc to levels (with the same
+ * keys and values as the initial layout of @p qc)
+ * @return The estimated number of nodes
+ */
+[[nodiscard]] fp estimateDDSize(const qc::QuantumComputation& qc,
+                                const qc::Permutation& order);
+
+/**
+ * @brief Propose a qubit order that keeps the DDs of a circuit small
+ * @details The qubits are arranged greedily along the weighted interaction
+ * graph of the circuit, such that each qubit is placed close to the qubits it
+ * interacts with most. The arrangement is then refined by sifting every qubit
+ * through the nearby positions with respect to estimateDDSize(), where the
+ * estimate is updated incrementally while a qubit moves. The number of
+ * sifting passes and the distance a qubit moves are bounded, such that the
+ * proposal takes time roughly proportional to the number of qubits times the
+ * number of distinct interactions. If the result is not estimated to be
+ * smaller, the initial layout is returned unchanged.
+ * @param qc The quantum computation
+ * @return The mapping from the qubits of @p qc to levels. It has the same keys
+ * and values as the initial layout of @p qc.
+ */
+[[nodiscard]] qc::Permutation
+proposeQubitOrder(const qc::QuantumComputation& qc);
+
+} // namespace dd
@@ -82,7 +82,9 @@ template <class Config>
  * @brief Computes an estimate for the peak memory usage of DDs.
  * @details The estimate is based on the peak number of used entries in the
  * respective memory managers. It accounts for the memory used by DD nodes, DD
- * edges, and real numbers.
+ * edges, and real numbers. Additionally, it includes the buckets of the real
+ * number table (see RealNumberUniqueTable), which occupy several MiB per
+ * package irrespective of the number of stored numbers.
  * @tparam Config The package configuration
  * @param package The package instance
  * @return The estimated memory usage in MiB
@@ -111,8 +113,11 @@ template <class Config>
   const auto peakRealNumbers =
       static_cast<double>(package->cMemoryManager.getStats().peakNumUsed);
   const auto memoryForRealNumbers = peakRealNumbers * REAL_NUMBER_MEMORY_MIB;
+  const auto memoryForRealNumberTable =
+      package->cUniqueTable.getStats().getMemoryMiB();
 
-  return memoryForNodes + memoryForEdges + memoryForRealNumbers;
+  return memoryForNodes + memoryForEdges + memoryForRealNumbers +
+         memoryForRealNumberTable;
 }
 
 template <class Config = DDPackageConfig>
@@ -158,6 +163,7 @@ getStatistics(Package<Config>* package,
       package->matrixKronecker.getStats().json();
   computeTables["vector_inner_product"] =
       package->vectorInnerProduct.getStats().json();
+  computeTables["operations"] = package->operationTable.getStats().json();
   computeTables["stochastic_noise_operations"] =
       package->stochasticNoiseOperationCache.getStats().json();
   computeTables["density_noise_operations"] =
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/statistics/UniqueTableStatistics.hpp"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace dd {
+
+/// Size of the referenced DDs after a single operation
+struct SizeSample {
+  /// Name of the operation
+  std::string name;
+  /// Number of referenced (non-terminal) nodes per level
+  std::vector<std::size_t> nodesPerLevel;
+  /// Total number of referenced (non-terminal) nodes
+  std::size_t nodes = 0U;
+};
+
+/// A contiguous range of operations during which the DD size was close to peak
+struct SizeRange {
+  /// Index of the first operation after which the size exceeded the threshold
+  std::size_t first = 0U;
+  /// Index of the last operation after which the size exceeded the threshold
+  std::size_t last = 0U;
+  /// Index of the operation with the smallest size preceding the range, i.e.,
+  /// the operations `growthStart + 1` to `first` built up the size
+  std::size_t growthStart = 0U;
+  /// Index of the operation after which the size within the range was maximal
+  std::size_t maxOperation = 0U;
+  /// The maximal size within the range
+  std::size_t maxNodes = 0U;
+};
+
+/// Summary of a size profile
+struct SizeReport {
+  /// The maximal total number of nodes over all operations
+  std::size_t peakNodes = 0U;
+  /// Index of the operation after which the peak was reached
+  std::size_t peakOperation = 0U;
+  /// The level with the most nodes at the peak
+  std::size_t peakLevel = 0U;
+  /// Operation ranges at which the size exceeded the threshold
+  std::vector<SizeRange> ranges;
+
+  /// Print a human-readable summary (naming the operations of @p samples)
+  void print(std::ostream& os, const std::vector<SizeSample>& samples) const;
+};
+
+/**
+ * @brief Incremental profiler of the DD size over the course of a computation
+ * @details Once attached to a package via Package::setSizeProfiler, the number
+ * of referenced nodes per level is recorded after every operation applied via
+ * applyUnitaryOperation (and, hence, during simulate() and
+ * buildFunctionality(); virtually executed SWAP gates are recorded as well so
+ * that sample indices match operation indices). The counts are read from the
+ * active entry statistics that the unique tables maintain anyway, so recording
+ * a sample is linear in the number of qubits instead of in the DD size.
+ * Note that these counts cover all DDs with a non-zero reference count, e.g.,
+ * further states kept alive by the caller.
+ */
+class SizeProfiler {
+public:
+  /// Record a sample from the per-level statistics of a unique table
+  void record(const std::string& name,
+              const std::vector<UniqueTableStatistics>& stats);
+
+  [[nodiscard]] const std::vector<SizeSample>& getSamples() const noexcept {
+    return samples;
+  }
+
+  /// Remove all recorded samples
+  void clear() noexcept { samples.clear(); }
+
+  /**
+   * @brief Identify the operations responsible for the peak size
+   * @param threshold Fraction of the peak size above which operations are
+   * considered to be part of a peak range
+   * @return The report (empty if no samples have been recorded)
+   */
+  [[nodiscard]] SizeReport report(double threshold = 0.9) const;
+
+  /// Export all samples as CSV (one line per operation, one column per level)
+  void exportCSV(std::ostream& os) const;
+  void exportCSV(const std::string& filename) const;
+
+private:
+  std::vector<SizeSample> samples;
+};
+
+} // namespace dd
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace dd {
+
+/**
+ * @brief Whether the profiling counters of the DD package are maintained
+ * @details Controlled by the `MQT_CORE_DD_STATISTICS` CMake option. If
+ * disabled, lookup, hit, collision, and insert counters of all tables compile
+ * to no-ops and always read zero.
+ */
+#ifdef MQT_CORE_DD_DISABLE_STATISTICS
+static constexpr bool STATISTICS_ENABLED = false;
+#else
+static constexpr bool STATISTICS_ENABLED = true;
+#endif
+
+/**
+ * @brief A counter that can be read from other threads while it is updated
+ * @details Every table (and, hence, every counter) is only ever modified by
+ * the thread owning the DD package. Updates are thus implemented as a relaxed
+ * load followed by a relaxed store instead of an atomic read-modify-write,
+ * which compiles to plain memory accesses on common architectures. At the
+ * same time, other threads (e.g., a monitoring thread) may read the counter
+ * without a data race and obtain a recent value. Copying a counter takes a
+ * snapshot of its current value.
+ * @tparam Enabled If false, all operations are no-ops and the counter always
+ * reads zero.
+ */
+template <bool Enabled = true> class StatisticsCounter {
+public:
+  StatisticsCounter() = default;
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  StatisticsCounter(const std::size_t v) noexcept : value(v) {}
+  StatisticsCounter(const StatisticsCounter& other) noexcept
+      : value(other.get()) {}
+  StatisticsCounter& operator=(const StatisticsCounter& other) noexcept {
+    set(other.get());
+    return *this;
+  }
+  StatisticsCounter& operator=(const std::size_t v) noexcept {
+    set(v);
+    return *this;
+  }
+  ~StatisticsCounter() = default;
+
+  [[nodiscard]] std::size_t get() const noexcept {
+    return value.load(std::memory_order_relaxed);
+  }
+  void set(const std::size_t v) noexcept {
+    value.store(v, std::memory_order_relaxed);
+  }
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  operator std::size_t() const noexcept { return get(); }
+
+  StatisticsCounter& operator++() noexcept {
+    set(get() + 1U);
+    return *this;
+  }
+  StatisticsCounter& operator--() noexcept {
+    set(get() - 1U);
+    return *this;
+  }
+  StatisticsCounter& operator+=(const std::size_t v) noexcept {
+    set(get() + v);
+    return *this;
+  }
+
+private:
+  std::atomic<std::size_t> value{0U};
+};
+
+/// Specialization for disabled counters that does not hold any state
+template <> class StatisticsCounter<false> {
+public:
+  StatisticsCounter() = default;
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  StatisticsCounter(const std::size_t /*v*/) noexcept {}
+  StatisticsCounter& operator=(const std::size_t /*v*/) noexcept {
+    return *this;
+  }
+
+  [[nodiscard]] static constexpr std::size_t get() noexcept { return 0U; }
+  static constexpr void set(const std::size_t /*v*/) noexcept {}
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr operator std::size_t() const noexcept { return 0U; }
+
+  StatisticsCounter& operator++() noexcept { return *this; }
+  StatisticsCounter& operator--() noexcept { return *this; }
+  StatisticsCounter& operator+=(const std::size_t /*v*/) noexcept {
+    return *this;
+  }
+};
+
+/// Counter for purely informational statistics (lookups, hits, ...)
+using ProfilingCounter = StatisticsCounter<STATISTICS_ENABLED>;
+
+} // namespace dd
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "dd/statistics/Statistics.hpp"
+#include "dd/statistics/StatisticsCounter.hpp"
 
 #include <cstddef>
 #include <nlohmann/json_fwd.hpp>
@@ -23,18 +24,18 @@ struct TableStatistics : public Statistics {
   /// The number of buckets in the table
   std::size_t numBuckets = 0U;
   /// The number of entries in the table
-  std::size_t numEntries = 0U;
+  StatisticsCounter<> numEntries = 0U;
   /// The peak number of entries in the table
-  std::size_t peakNumEntries = 0U;
+  StatisticsCounter<> peakNumEntries = 0U;
 
   /// The number of collisions
-  std::size_t collisions = 0U;
+  ProfilingCounter collisions = 0U;
   /// The number of successful lookups
-  std::size_t hits = 0U;
+  ProfilingCounter hits = 0U;
   /// The number of lookups
-  std::size_t lookups = 0U;
+  ProfilingCounter lookups = 0U;
   /// The number of inserts
-  std::size_t inserts = 0U;
+  ProfilingCounter inserts = 0U;
 
   /// Track a new insert
   void trackInsert() noexcept;
@@ -71,6 +72,9 @@ struct TableStatistics : public Statistics {
   /// Get the amount of memory required for the table in MiB
   [[nodiscard]] double getMemoryMiB() const noexcept;
 
+  /// Whether the table has not been used at all
+  [[nodiscard]] bool unused() const noexcept;
+
   /// Get a JSON representation of the statistics
   [[nodiscard]] nlohmann::json json() const override;
 };
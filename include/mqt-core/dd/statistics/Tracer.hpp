@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dd {
+
+/// A single event recorded by a Tracer
+struct TraceEvent {
+  enum class Type : std::uint8_t { Operation, GarbageCollection };
+
+  Type type = Type::Operation;
+  /// Name of the operation (or "garbage_collection")
+  std::string name;
+  /// Start time in microseconds since the creation of the tracer
+  double start = 0.;
+  /// Duration in microseconds
+  double duration = 0.;
+  /// Number of nodes of the resulting DD (operations only)
+  std::size_t ddSize = 0U;
+  /// Change of the number of entries in the node unique tables
+  std::int64_t uniqueTableGrowth = 0;
+  /// Number of compute table lookups during the event
+  std::size_t computeTableLookups = 0U;
+  /// Number of successful compute table lookups during the event
+  std::size_t computeTableHits = 0U;
+  /// Number of collected table entries (garbage collection only)
+  std::size_t collected = 0U;
+
+  /// Ratio of successful compute table lookups during the event
+  [[nodiscard]] double hitRatio() const noexcept;
+};
+
+/**
+ * @brief Opt-in recorder for per-operation timing and DD statistics
+ * @details Once attached to a package via Package::setTracer, every operation
+ * applied through applyUnitaryOperation and every garbage collection run that
+ * actually visits the unique tables is recorded as an event. The recorded
+ * timeline can be exported as Chrome trace JSON (viewable, e.g., in
+ * `chrome://tracing` or Perfetto) or as CSV.
+ */
+class Tracer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  Tracer() : origin(Clock::now()) {}
+
+  /// Microseconds elapsed since the creation (or last clear) of the tracer
+  [[nodiscard]] double now() const;
+
+  /// Record an event and return a reference to the stored event
+  TraceEvent& record(TraceEvent event) {
+    return events.emplace_back(std::move(event));
+  }
+
+  [[nodiscard]] const std::vector<TraceEvent>& getEvents() const noexcept {
+    return events;
+  }
+
+  /// Remove all recorded events and restart the clock
+  void clear();
+
+  /// Export all events in the Chrome trace event format
+  void exportChromeTrace(std::ostream& os) const;
+  void exportChromeTrace(const std::string& filename) const;
+
+  /// Export all events as CSV (one line per event)
+  void exportCSV(std::ostream& os) const;
+  void exportCSV(const std::string& filename) const;
+
+private:
+  Clock::time_point origin;
+  std::vector<TraceEvent> events;
+};
+
+/**
+ * @brief Quote a CSV field if necessary
+ * @details Fields containing commas, quotes, or line breaks are enclosed in
+ * quotes, with embedded quotes doubled (RFC 4180).
+ */
+[[nodiscard]] std::string csvField(const std::string& field);
+
+} // namespace dd
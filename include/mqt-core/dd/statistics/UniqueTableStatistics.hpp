@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "dd/statistics/StatisticsCounter.hpp"
 #include "dd/statistics/TableStatistics.hpp"
 
 #include <cstddef>
@@ -21,11 +22,11 @@ struct UniqueTableStatistics : public TableStatistics {
    * @brief The total number of active entries
    * @details An entry is considered active if it has a non-zero reference count
    */
-  std::size_t numActiveEntries = 0U;
+  StatisticsCounter<> numActiveEntries = 0U;
   /// The peak number of active entries in the table
-  std::size_t peakNumActiveEntries = 0U;
+  StatisticsCounter<> peakNumActiveEntries = 0U;
   /// The number of garbage collection runs
-  std::size_t gcRuns = 0U;
+  StatisticsCounter<> gcRuns = 0U;
 
   /// Track a new active entry
   void trackActiveEntry() noexcept;
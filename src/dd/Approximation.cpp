@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/Approximation.hpp"
+
+#include "dd/CachedEdge.hpp"
+#include "dd/ComplexNumbers.hpp"
+#include "dd/ComplexValue.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace dd {
+
+namespace {
+/**
+ * @brief Rebuild a vector DD without the given nodes
+ * @param p The node to rebuild
+ * @param removed The nodes that are replaced by the zero vector
+ * @param dd The DD package
+ * @param cache Already rebuilt nodes
+ * @return The rebuilt (not normalized to unit norm) sub-vector of @p p
+ */
+template <class Config>
+vCachedEdge rebuild(vNode* p, const std::unordered_set<const vNode*>& removed,
+                    Package<Config>& dd,
+                    std::unordered_map<const vNode*, vCachedEdge>& cache) {
+  if (vNode::isTerminal(p)) {
+    return vCachedEdge::one();
+  }
+  if (removed.count(p) != 0U) {
+    return vCachedEdge::zero();
+  }
+  if (const auto it = cache.find(p); it != cache.end()) {
+    return it->second;
+  }
+
+  std::array<vCachedEdge, RADIX> edges{};
+  for (std::size_t i = 0U; i < RADIX; ++i) {
+    const auto& child = p->e[i];
+    if (child.w.exactlyZero()) {
+      edges[i] = vCachedEdge::zero();
+      continue;
+    }
+    const auto r = rebuild(child.p, removed, dd, cache);
+    if (r.w.exactlyZero()) {
+      edges[i] = vCachedEdge::zero();
+      continue;
+    }
+    edges[i] = {r.p, r.w * child.w};
+  }
+  auto r = dd.template makeDDNode<vNode, CachedEdge>(p->v, edges);
+  cache.emplace(p, r);
+  return r;
+}
+} // namespace
+
+template <class Config>
+fp approximate(vEdge& state, const std::size_t maxNodes, Package<Config>& dd,
+               ApproximationMetadata& metadata) {
+  if (state.isTerminal()) {
+    return 1.;
+  }
+
+  // collect all nodes of the DD in the order of their first visit (which only
+  // depends on the structure of the DD) and group them by their level
+  std::vector<const vNode*> nodes{state.p};
+  std::unordered_map<const vNode*, std::size_t> index{{state.p, 0U}};
+  std::vector<std::vector<std::size_t>> levels(state.p->v + 1U);
+  std::vector<std::size_t> stack{0U};
+  while (!stack.empty()) {
+    const auto i = stack.back();
+    stack.pop_back();
+    levels[nodes[i]->v].emplace_back(i);
+    for (const auto& child : nodes[i]->e) {
+      if (!child.isTerminal() &&
+          index.emplace(child.p, nodes.size()).second) {
+        stack.emplace_back(nodes.size());
+        nodes.emplace_back(child.p);
+      }
+    }
+  }
+  // the terminal node counts towards the size of the DD
+  const auto size = nodes.size() + 1U;
+  if (size <= maxNodes) {
+    return 1.;
+  }
+
+  // propagate the contributions from the root to the bottom of the DD. Since
+  // every node represents a unit-norm vector, the contribution of a node is
+  // distributed to its successors according to the squared edge weights.
+  std::vector<fp> contribution{1.};
+  contribution.resize(nodes.size(), 0.);
+  for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+    for (const auto i : *level) {
+      for (const auto& child : nodes[i]->e) {
+        if (!child.isTerminal()) {
+          contribution[index[child.p]] +=
+              contribution[i] * ComplexNumbers::mag2(child.w);
+        }
+      }
+    }
+  }
+
+  // ties are broken by level and then by the order of the first visit, such
+  // that the result does not depend on the memory layout of the nodes
+  std::vector<std::size_t> candidates(nodes.size() - 1U);
+  std::iota(candidates.begin(), candidates.end(), 1U);
+  std::sort(candidates.begin(), candidates.end(),
+            [&](const std::size_t a, const std::size_t b) {
+              return std::tuple{contribution[a], nodes[a]->v, a} <
+                     std::tuple{contribution[b], nodes[b]->v, b};
+            });
+
+  // the path following the heaviest successors is never removed since it
+  // guarantees that the approximated state is not the zero vector
+  std::unordered_set<const vNode*> protectedNodes{};
+  for (const auto* p = state.p; !vNode::isTerminal(p);) {
+    protectedNodes.emplace(p);
+    const auto& e0 = p->e[0];
+    const auto& e1 = p->e[1];
+    p = ComplexNumbers::mag2(e0.w) >= ComplexNumbers::mag2(e1.w) ? e0.p : e1.p;
+  }
+
+  const auto toRemove = size - std::max<std::size_t>(maxNodes, 2U);
+  std::unordered_set<const vNode*> removed{};
+  for (const auto i : candidates) {
+    if (removed.size() >= toRemove) {
+      break;
+    }
+    if (protectedNodes.count(nodes[i]) == 0U) {
+      removed.emplace(nodes[i]);
+    }
+  }
+  if (removed.empty()) {
+    return 1.;
+  }
+
+  std::unordered_map<const vNode*, vCachedEdge> cache{};
+  const auto r = rebuild(state.p, removed, dd, cache);
+  // the weight of the rebuilt root is the norm of the remaining sub-vector
+  const auto norm = r.w.mag();
+  const auto fidelity = norm * norm;
+  const auto approximated = dd.cn.lookup(vCachedEdge{
+      r.p, (r.w * (1. / norm)) * static_cast<ComplexValue>(state.w)});
+
+  dd.incRef(approximated);
+  dd.decRef(state);
+  dd.garbageCollect();
+  state = approximated;
+
+  metadata.fidelity *= fidelity;
+  ++metadata.rounds;
+  metadata.removedNodes += removed.size();
+  return fidelity;
+}
+
+template fp approximate<DDPackageConfig>(vEdge& state, std::size_t maxNodes,
+                                         Package<DDPackageConfig>& dd,
+                                         ApproximationMetadata& metadata);
+} // namespace dd
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/Checkpoint.hpp"
+
+#include "Definitions.hpp"
+#include "dd/DDpackageConfig.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package.hpp"
+#include "dd/Serialization.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/ClassicControlledOperation.hpp"
+#include "ir/operations/CompoundOperation.hpp"
+#include "ir/operations/Operation.hpp"
+#include "ir/operations/SymbolicOperation.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace dd {
+
+namespace {
+template <class T> void writeValue(std::ostream& os, const T& value) {
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+T readValue(const std::vector<char>& buffer, std::size_t& pos) {
+  if (buffer.size() - pos < sizeof(T)) {
+    throw std::runtime_error("Checkpoint is truncated.");
+  }
+  T value{};
+  std::memcpy(&value, buffer.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return value;
+}
+
+/// Hash of an operation including the operations nested in it
+std::size_t operationFingerprint(const qc::Operation& op) {
+  if (const auto* compound = dynamic_cast<const qc::CompoundOperation*>(&op);
+      compound != nullptr) {
+    std::size_t seed = 0U;
+    for (const auto& nested : *compound) {
+      qc::hashCombine(seed, operationFingerprint(*nested));
+    }
+    return seed;
+  }
+  if (const auto* classic =
+          dynamic_cast<const qc::ClassicControlledOperation*>(&op);
+      classic != nullptr) {
+    auto seed = std::hash<qc::ClassicControlledOperation>{}(*classic);
+    qc::hashCombine(seed, operationFingerprint(*classic->getOperation()));
+    return seed;
+  }
+  if (const auto* symbolic = dynamic_cast<const qc::SymbolicOperation*>(&op);
+      symbolic != nullptr) {
+    return std::hash<qc::SymbolicOperation>{}(*symbolic);
+  }
+  return std::hash<qc::Operation>{}(op);
+}
+
+/// Write the contents of a closed file to the disk
+void syncFile(const std::string& filename) {
+#if defined(__unix__) || defined(__APPLE__)
+  const auto fd = ::open(filename.c_str(), O_RDONLY);
+  const auto synced = fd >= 0 && ::fsync(fd) == 0;
+  if (fd >= 0) {
+    ::close(fd);
+  }
+#elif defined(_WIN32)
+  const auto fd = ::_open(filename.c_str(), _O_RDWR | _O_BINARY);
+  const auto synced = fd >= 0 && ::_commit(fd) == 0;
+  if (fd >= 0) {
+    ::_close(fd);
+  }
+#else
+  const auto synced = true;
+#endif
+  if (!synced) {
+    throw std::runtime_error("Failed to sync checkpoint: " + filename);
+  }
+}
+} // namespace
+
+std::uint64_t circuitFingerprint(const qc::QuantumComputation& qc) {
+  std::size_t seed = 0U;
+  qc::hashCombine(seed, qc.getNqubits());
+  qc::hashCombine(seed, std::hash<qc::Permutation>{}(qc.initialLayout));
+  qc::hashCombine(seed, std::hash<qc::Permutation>{}(qc.outputPermutation));
+  for (const auto& op : qc) {
+    qc::hashCombine(seed, operationFingerprint(*op));
+  }
+  return seed;
+}
+
+void saveCheckpoint(const std::string& filename,
+                    const SimulationCheckpoint& checkpoint,
+                    const bool compress) {
+  const auto tmpFilename = filename + ".tmp";
+  {
+    std::ofstream ofs(tmpFilename, std::ios::binary);
+    if (!ofs.good()) {
+      throw std::invalid_argument("Cannot open file: " + tmpFilename);
+    }
+    ofs.write(CHECKPOINT_MAGIC.data(), CHECKPOINT_MAGIC.size());
+    writeValue(ofs, CHECKPOINT_VERSION);
+    writeValue(ofs, std::uint64_t{checkpoint.nextOperation});
+    writeValue(ofs, std::uint64_t{checkpoint.numOperations});
+    writeValue(ofs, checkpoint.fingerprint);
+    writeValue(ofs, std::uint64_t{checkpoint.permutation.size()});
+    for (const auto& [logical, physical] : checkpoint.permutation) {
+      writeValue(ofs, logical);
+      writeValue(ofs, physical);
+    }
+    writeValue(ofs, std::uint64_t{checkpoint.rngState.size()});
+    ofs.write(checkpoint.rngState.data(),
+              static_cast<std::streamsize>(checkpoint.rngState.size()));
+    serializeCompact(checkpoint.state, ofs, compress);
+    ofs.flush();
+    if (!ofs.good()) {
+      throw std::runtime_error("Failed to write checkpoint: " + tmpFilename);
+    }
+  }
+  // the new checkpoint has to be on the disk before it replaces the old one
+  syncFile(tmpFilename);
+  std::filesystem::rename(tmpFilename, filename);
+}
+
+template <class Config>
+SimulationCheckpoint loadCheckpoint(const std::string& filename,
+                                    Package<Config>& dd) {
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs.good()) {
+    throw std::invalid_argument("Cannot open checkpoint file: " + filename);
+  }
+  const std::vector<char> buffer{std::istreambuf_iterator<char>(ifs),
+                                 std::istreambuf_iterator<char>()};
+
+  std::size_t pos = 0U;
+  const auto magic = readValue<std::array<char, 8>>(buffer, pos);
+  if (magic != CHECKPOINT_MAGIC) {
+    throw std::runtime_error("File is not a simulation checkpoint: " +
+                             filename);
+  }
+  const auto version = readValue<std::uint32_t>(buffer, pos);
+  if (version != CHECKPOINT_VERSION) {
+    throw std::runtime_error(
+        "Wrong Version of checkpoint file version. version of file: " +
+        std::to_string(version) +
+        "; current version: " + std::to_string(CHECKPOINT_VERSION));
+  }
+
+  SimulationCheckpoint checkpoint{};
+  checkpoint.nextOperation = readValue<std::uint64_t>(buffer, pos);
+  checkpoint.numOperations = readValue<std::uint64_t>(buffer, pos);
+  checkpoint.fingerprint = readValue<std::uint64_t>(buffer, pos);
+  const auto numMappings = readValue<std::uint64_t>(buffer, pos);
+  for (std::uint64_t i = 0U; i < numMappings; ++i) {
+    const auto logical = readValue<qc::Qubit>(buffer, pos);
+    checkpoint.permutation[logical] = readValue<qc::Qubit>(buffer, pos);
+  }
+  const auto rngStateSize = readValue<std::uint64_t>(buffer, pos);
+  if (buffer.size() - pos < rngStateSize) {
+    throw std::runtime_error("Checkpoint is truncated.");
+  }
+  checkpoint.rngState.assign(buffer.data() + pos, rngStateSize);
+  pos += rngStateSize;
+
+  checkpoint.state = deserializeCompact<vNode>(buffer.data() + pos,
+                                               buffer.size() - pos, dd);
+  dd.incRef(checkpoint.state);
+  return checkpoint;
+}
+
+template SimulationCheckpoint
+loadCheckpoint<DDPackageConfig>(const std::string& filename,
+                                Package<DDPackageConfig>& dd);
+} // namespace dd
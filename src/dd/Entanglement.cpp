@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/Entanglement.hpp"
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/Node.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dd {
+
+namespace {
+/// Squared Schmidt coefficients below this fraction of the norm are dropped
+constexpr fp SPECTRUM_TOLERANCE = 1e-12;
+/// The maximal number of sweeps of the Jacobi eigenvalue algorithm
+constexpr std::size_t MAX_JACOBI_SWEEPS = 64U;
+
+using RMat = std::vector<std::vector<fp>>;
+
+/**
+ * @brief The Gram matrices of the nodes on each level of a vector DD
+ * @details For the nodes u, w on level v, `above[v][u][w]` is the inner
+ * product <a_u|a_w> of the (weighted) paths from the root to u and w, and
+ * `below[v][u][w]` is the inner product <φ_u|φ_w> of the sub-DDs rooted at u
+ * and w (without their incoming edge weights). Vector DDs do not skip levels,
+ * so the matrices of each level follow from those of the adjacent level.
+ */
+class LevelGrams {
+public:
+  explicit LevelGrams(const vEdge& state) {
+    if (state.isTerminal()) {
+      return;
+    }
+    const auto nqubits = static_cast<std::size_t>(state.p->v) + 1U;
+    nodes.resize(nqubits);
+    index.resize(nqubits);
+    collect(state.p);
+    above.resize(nqubits);
+    below.resize(nqubits);
+    computeAbove(state);
+    computeBelow();
+  }
+
+  [[nodiscard]] std::size_t nqubits() const noexcept { return nodes.size(); }
+
+  /// The squared Schmidt coefficients across the cut above level `cut - 1`
+  [[nodiscard]] std::vector<fp> spectrum(std::size_t cut) const;
+
+private:
+  std::vector<std::vector<const vNode*>> nodes;
+  std::vector<std::unordered_map<const vNode*, std::size_t>> index;
+  std::vector<CMat> above;
+  std::vector<CMat> below;
+
+  void collect(const vNode* p) {
+    const auto v = static_cast<std::size_t>(p->v);
+    if (!index[v].emplace(p, nodes[v].size()).second) {
+      return;
+    }
+    nodes[v].emplace_back(p);
+    for (const auto& e : p->e) {
+      if (!e.isTerminal() && !e.w.exactlyZero()) {
+        collect(e.p);
+      }
+    }
+  }
+
+  void computeAbove(const vEdge& root) {
+    for (std::size_t v = 0U; v < nodes.size(); ++v) {
+      above[v].assign(nodes[v].size(), CVec(nodes[v].size(), 0.));
+    }
+    const auto w = static_cast<std::complex<fp>>(root.w);
+    above.back()[0][0] = std::norm(w);
+    for (auto v = nodes.size() - 1U; v > 0U; --v) {
+      const auto& level = nodes[v];
+      for (std::size_t i = 0U; i < level.size(); ++i) {
+        for (std::size_t j = 0U; j < level.size(); ++j) {
+          const auto g = above[v][i][j];
+          if (g == 0.) {
+            continue;
+          }
+          for (std::size_t b = 0U; b < RADIX; ++b) {
+            const auto& x = level[i]->e[b];
+            const auto& y = level[j]->e[b];
+            if (x.w.exactlyZero() || y.w.exactlyZero()) {
+              continue;
+            }
+            above[v - 1U][index[v - 1U].at(x.p)][index[v - 1U].at(y.p)] +=
+                g * std::conj(static_cast<std::complex<fp>>(x.w)) *
+                static_cast<std::complex<fp>>(y.w);
+          }
+        }
+      }
+    }
+  }
+
+  void computeBelow() {
+    for (std::size_t v = 0U; v < nodes.size(); ++v) {
+      const auto& level = nodes[v];
+      below[v].assign(level.size(), CVec(level.size(), 0.));
+      for (std::size_t i = 0U; i < level.size(); ++i) {
+        for (std::size_t j = 0U; j < level.size(); ++j) {
+          std::complex<fp> sum = 0.;
+          for (std::size_t b = 0U; b < RADIX; ++b) {
+            const auto& x = level[i]->e[b];
+            const auto& y = level[j]->e[b];
+            if (x.w.exactlyZero() || y.w.exactlyZero()) {
+              continue;
+            }
+            auto product = std::conj(static_cast<std::complex<fp>>(x.w)) *
+                           static_cast<std::complex<fp>>(y.w);
+            if (v > 0U) {
+              product *=
+                  below[v - 1U][index[v - 1U].at(x.p)][index[v - 1U].at(y.p)];
+            }
+            sum += product;
+          }
+          below[v][i][j] = sum;
+        }
+      }
+    }
+  }
+};
+
+/// The real symmetric matrix [[X, -Y], [Y, X]] of the Hermitian matrix X + iY
+RMat realEmbedding(const CMat& h) {
+  const auto n = h.size();
+  RMat r(2U * n, std::vector<fp>(2U * n, 0.));
+  for (std::size_t i = 0U; i < n; ++i) {
+    for (std::size_t j = 0U; j < n; ++j) {
+      r[i][j] = h[i][j].real();
+      r[i + n][j + n] = h[i][j].real();
+      r[i][j + n] = -h[i][j].imag();
+      r[i + n][j] = h[i][j].imag();
+    }
+  }
+  return r;
+}
+
+/**
+ * @brief Diagonalize a real symmetric matrix with the cyclic Jacobi method
+ * @param a The matrix. Replaced by the diagonal matrix of eigenvalues.
+ * @param v The orthogonal matrix whose columns are the eigenvectors
+ */
+void jacobiEigen(RMat& a, RMat& v) {
+  const auto n = a.size();
+  v.assign(n, std::vector<fp>(n, 0.));
+  for (std::size_t i = 0U; i < n; ++i) {
+    v[i][i] = 1.;
+  }
+  fp norm = 0.;
+  for (const auto& row : a) {
+    for (const auto x : row) {
+      norm += x * x;
+    }
+  }
+  for (std::size_t sweep = 0U; sweep < MAX_JACOBI_SWEEPS; ++sweep) {
+    fp off = 0.;
+    for (std::size_t p = 0U; p < n; ++p) {
+      for (std::size_t q = p + 1U; q < n; ++q) {
+        off += a[p][q] * a[p][q];
+      }
+    }
+    if (off <= 1e-30 * norm) {
+      return;
+    }
+    for (std::size_t p = 0U; p < n; ++p) {
+      for (std::size_t q = p + 1U; q < n; ++q) {
+        if (a[p][q] == 0.) {
+          continue;
+        }
+        // rotate by the angle that annihilates a[p][q]
+        const auto theta = (a[q][q] - a[p][p]) / (2. * a[p][q]);
+        const auto t = std::copysign(1., theta) /
+                       (std::abs(theta) + std::sqrt((theta * theta) + 1.));
+        const auto c = 1. / std::sqrt((t * t) + 1.);
+        const auto s = t * c;
+        for (std::size_t k = 0U; k < n; ++k) {
+          const auto akp = a[k][p];
+          const auto akq = a[k][q];
+          a[k][p] = (c * akp) - (s * akq);
+          a[k][q] = (s * akp) + (c * akq);
+        }
+        for (std::size_t k = 0U; k < n; ++k) {
+          const auto apk = a[p][k];
+          const auto aqk = a[q][k];
+          a[p][k] = (c * apk) - (s * aqk);
+          a[q][k] = (s * apk) + (c * aqk);
+        }
+        for (std::size_t k = 0U; k < n; ++k) {
+          const auto vkp = v[k][p];
+          const auto vkq = v[k][q];
+          v[k][p] = (c * vkp) - (s * vkq);
+          v[k][q] = (s * vkp) + (c * vkq);
+        }
+      }
+    }
+  }
+}
+
+std::vector<fp> LevelGrams::spectrum(const std::size_t cut) const {
+  if (cut == 0U || cut >= nqubits()) {
+    return {1.};
+  }
+  const auto& gram = above[cut - 1U];
+  const auto r = gram.size();
+  // C_jk = <a_k|a_j>, i.e., the transpose of the Gram matrix of the paths
+  CMat c(r, CVec(r));
+  for (std::size_t j = 0U; j < r; ++j) {
+    for (std::size_t k = 0U; k < r; ++k) {
+      c[j][k] = gram[k][j];
+    }
+  }
+
+  // With C = V·D·V^T, the eigenvalues of C·G are those of the symmetric
+  // matrix D^(1/2)·V^T·G·V·D^(1/2). The real embedding of the complex
+  // matrices doubles every eigenvalue.
+  auto d = realEmbedding(c);
+  RMat v{};
+  jacobiEigen(d, v);
+  const auto g = realEmbedding(below[cut - 1U]);
+  const auto n = g.size();
+  RMat gv(n, std::vector<fp>(n, 0.));
+  for (std::size_t i = 0U; i < n; ++i) {
+    for (std::size_t k = 0U; k < n; ++k) {
+      for (std::size_t j = 0U; j < n; ++j) {
+        gv[i][j] += g[i][k] * v[k][j];
+      }
+    }
+  }
+  std::vector<fp> sqrtD(n);
+  for (std::size_t i = 0U; i < n; ++i) {
+    sqrtD[i] = std::sqrt(std::max(d[i][i], 0.));
+  }
+  RMat m(n, std::vector<fp>(n, 0.));
+  for (std::size_t i = 0U; i < n; ++i) {
+    for (std::size_t j = 0U; j < n; ++j) {
+      fp sum = 0.;
+      for (std::size_t k = 0U; k < n; ++k) {
+        sum += v[k][i] * gv[k][j];
+      }
+      m[i][j] = sqrtD[i] * sum * sqrtD[j];
+    }
+  }
+  RMat unused{};
+  jacobiEigen(m, unused);
+
+  std::vector<fp> eigenvalues(n);
+  for (std::size_t i = 0U; i < n; ++i) {
+    eigenvalues[i] = m[i][i];
+  }
+  std::sort(eigenvalues.begin(), eigenvalues.end(), std::greater<>());
+  std::vector<fp> result{};
+  for (std::size_t i = 0U; i < n; i += 2U) {
+    result.emplace_back(std::max(eigenvalues[i], 0.));
+  }
+  return result;
+}
+
+/// Normalize a spectrum to a probability distribution and drop tiny entries
+std::vector<fp> normalize(std::vector<fp> spectrum) {
+  fp total = 0.;
+  for (const auto x : spectrum) {
+    total += x;
+  }
+  if (total <= 0.) {
+    return {};
+  }
+  std::vector<fp> result{};
+  for (const auto x : spectrum) {
+    if (x > SPECTRUM_TOLERANCE * total) {
+      result.emplace_back(x / total);
+    }
+  }
+  return result;
+}
+
+fp entropy(const std::vector<fp>& probabilities) {
+  fp sum = 0.;
+  for (const auto p : probabilities) {
+    sum -= p * std::log2(p);
+  }
+  return std::max(sum, 0.);
+}
+
+std::size_t stateQubits(const vEdge& state) {
+  return state.isTerminal() ? 0U : static_cast<std::size_t>(state.p->v) + 1U;
+}
+
+void checkCut(const vEdge& state, const std::size_t cut) {
+  if (cut > stateQubits(state)) {
+    throw std::invalid_argument("Cut " + std::to_string(cut) +
+                                " exceeds the number of qubits " +
+                                std::to_string(stateQubits(state)) + ".");
+  }
+}
+} // namespace
+
+std::vector<fp> schmidtCoefficients(const vEdge& state, const std::size_t cut) {
+  checkCut(state, cut);
+  if (state.w.exactlyZero()) {
+    return {};
+  }
+  auto coefficients = normalize(LevelGrams(state).spectrum(cut));
+  for (auto& c : coefficients) {
+    c = std::sqrt(c);
+  }
+  return coefficients;
+}
+
+fp entanglementEntropy(const vEdge& state, const std::size_t cut) {
+  checkCut(state, cut);
+  if (state.w.exactlyZero()) {
+    return 0.;
+  }
+  return entropy(normalize(LevelGrams(state).spectrum(cut)));
+}
+
+std::vector<fp> entanglementProfile(const vEdge& state) {
+  const auto nqubits = stateQubits(state);
+  std::vector<fp> profile(nqubits + 1U, 0.);
+  if (state.w.exactlyZero()) {
+    return profile;
+  }
+  const LevelGrams grams(state);
+  for (std::size_t cut = 1U; cut < nqubits; ++cut) {
+    profile[cut] = entropy(normalize(grams.spectrum(cut)));
+  }
+  return profile;
+}
+
+} // namespace dd
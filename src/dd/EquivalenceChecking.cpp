@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/EquivalenceChecking.hpp"
+
+#include "dd/ComplexNumbers.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/Node.hpp"
+#include "dd/Operations.hpp"
+#include "dd/Package.hpp"
+#include "dd/Simulation.hpp"
+#include "ir/Permutation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/OpType.hpp"
+#include "ir/operations/Operation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace dd {
+
+namespace {
+/// The operations of a circuit that contribute to its functionality
+std::vector<const qc::Operation*>
+unitaryOperations(const qc::QuantumComputation& qc) {
+  std::vector<const qc::Operation*> ops{};
+  ops.reserve(qc.size());
+  for (const auto& op : qc) {
+    if (op->getType() == qc::Barrier) {
+      continue;
+    }
+    if (!op->isUnitary()) {
+      throw std::invalid_argument(
+          "Equivalence checking requires unitary circuits, but the circuit "
+          "contains the non-unitary operation " +
+          op->getName() + ".");
+    }
+    ops.emplace_back(op.get());
+  }
+  return ops;
+}
+
+bool isVirtualSwap(const qc::Operation* op) {
+  return op->getType() == qc::SWAP && !op->isControlled();
+}
+
+/// Combine the flags (e.g., ancillary or garbage qubits) of both circuits
+std::vector<bool> combine(const std::vector<bool>& lhs,
+                          const std::vector<bool>& rhs) {
+  std::vector<bool> result(std::max(lhs.size(), rhs.size()), false);
+  for (std::size_t i = 0U; i < result.size(); ++i) {
+    result[i] = (i < lhs.size() && lhs[i]) || (i < rhs.size() && rhs[i]);
+  }
+  return result;
+}
+
+/**
+ * @brief Count the nodes of a DD like Edge::size()
+ * @details Since the size is determined after every gate, the visited set is
+ * reused, which avoids clearing the large static set of Edge::size() for the
+ * (typically small) intermediate DDs.
+ */
+std::size_t countNodes(const mEdge& e,
+                       std::unordered_set<const mNode*>& visited) {
+  if (!visited.emplace(e.p).second) {
+    return 0U;
+  }
+  std::size_t sum = 1U;
+  if (!e.isTerminal()) {
+    for (const auto& successor : e.p->e) {
+      sum += countNodes(successor, visited);
+    }
+  }
+  return sum;
+}
+
+/// Generate random input states for falsifyEquivalence()
+std::vector<std::vector<BasisStates>>
+generateStimuli(const std::size_t nqubits, const std::vector<bool>& ancillary,
+                const FalsificationConfiguration& config) {
+  std::mt19937_64 mt{};
+  if (config.seed != 0U) {
+    mt.seed(config.seed);
+  } else {
+    // create and properly seed rng
+    std::array<std::mt19937_64::result_type, std::mt19937_64::state_size>
+        randomData{};
+    std::random_device rd;
+    std::generate(std::begin(randomData), std::end(randomData),
+                  [&rd]() { return rd(); });
+    std::seed_seq seeds(std::begin(randomData), std::end(randomData));
+    mt.seed(seeds);
+  }
+  const auto states = config.type == StimuliType::Classical ? 2U : 6U;
+  std::uniform_int_distribution<unsigned> dist(0U, states - 1U);
+
+  std::vector<std::vector<BasisStates>> stimuli(config.stimuli);
+  for (auto& stimulus : stimuli) {
+    stimulus.resize(nqubits, BasisStates::zero);
+    for (std::size_t q = 0U; q < nqubits; ++q) {
+      const auto state = static_cast<BasisStates>(dist(mt));
+      if (q >= ancillary.size() || !ancillary[q]) {
+        stimulus[q] = state;
+      }
+    }
+  }
+  return stimuli;
+}
+} // namespace
+
+template <class Config>
+EquivalenceCheckingResult
+checkEquivalence(const qc::QuantumComputation& qc1,
+                 const qc::QuantumComputation& qc2, Package<Config>& dd,
+                 const EquivalenceCheckingConfiguration& config) {
+  if (qc1.getNqubits() != qc2.getNqubits()) {
+    throw std::invalid_argument(
+        "Equivalence checking requires circuits with the same number of "
+        "qubits.");
+  }
+  const auto left = unitaryOperations(qc1);
+  const auto right = unitaryOperations(qc2);
+
+  EquivalenceCheckingResult result{};
+  auto perm1 = qc1.initialLayout;
+  auto perm2 = qc2.initialLayout;
+  auto e = dd.createInitialMatrix(combine(qc1.ancillary, qc2.ancillary));
+  dd.incRef(e);
+  std::unordered_set<const mNode*> visited{};
+  const auto size = [&visited](const mEdge& edge) {
+    visited.clear();
+    return countNodes(edge, visited);
+  };
+  result.peakNodes = size(e);
+
+  const auto replace = [&dd, &e](const mEdge& next) {
+    dd.incRef(next);
+    dd.decRef(e);
+    e = next;
+    dd.garbageCollect();
+  };
+  // gates of the first circuit are applied from the left
+  const auto applyLeft = [&]() {
+    const auto* op = left[result.appliedLeft++];
+    if (isVirtualSwap(op)) {
+      const auto& targets = op->getTargets();
+      std::swap(perm1.at(targets[0U]), perm1.at(targets[1U]));
+      return;
+    }
+    replace(dd.multiply(getDD(op, dd, perm1), e));
+  };
+  // inverted gates of the second circuit are applied from the right
+  const auto applyRight = [&]() {
+    const auto* op = right[result.appliedRight++];
+    if (isVirtualSwap(op)) {
+      const auto& targets = op->getTargets();
+      std::swap(perm2.at(targets[0U]), perm2.at(targets[1U]));
+      return;
+    }
+    replace(dd.multiply(e, getInverseDD(op, dd, perm2)));
+  };
+
+  while (result.appliedLeft < left.size() ||
+         result.appliedRight < right.size()) {
+    const auto i = result.appliedLeft;
+    const auto j = result.appliedRight;
+    if (i == left.size()) {
+      applyRight();
+    } else if (j == right.size()) {
+      applyLeft();
+    } else {
+      switch (config.scheme) {
+      case AlternatingScheme::OneToOne:
+        if (i <= j) {
+          applyLeft();
+        } else {
+          applyRight();
+        }
+        break;
+      case AlternatingScheme::Proportional:
+        // i / |G| <= j / |G'|, i.e., the first circuit is not ahead
+        if (i * right.size() <= j * left.size()) {
+          applyLeft();
+        } else {
+          applyRight();
+        }
+        break;
+      case AlternatingScheme::Lookahead:
+        // virtual SWAPs come for free and are applied right away
+        if (isVirtualSwap(left[i])) {
+          applyLeft();
+        } else if (isVirtualSwap(right[j])) {
+          applyRight();
+        } else {
+          // both candidates are unreferenced until one of them is kept
+          const auto l = dd.multiply(getDD(left[i], dd, perm1), e);
+          const auto r = dd.multiply(e, getInverseDD(right[j], dd, perm2));
+          if (size(l) <= size(r)) {
+            ++result.appliedLeft;
+            replace(l);
+          } else {
+            ++result.appliedRight;
+            replace(r);
+          }
+        }
+        break;
+      }
+    }
+
+    result.peakNodes = std::max(result.peakNodes, size(e));
+    if (config.maxNodes != 0U && result.peakNodes > config.maxNodes) {
+      dd.decRef(e);
+      return result;
+    }
+  }
+
+  changePermutation(e, perm1, qc1.outputPermutation, dd);
+  changePermutation(e, perm2, qc2.outputPermutation, dd, false);
+
+  const auto garbage = combine(qc1.garbage, qc2.garbage);
+  if (!dd.isCloseToIdentity(e, config.tolerance, garbage)) {
+    result.equivalence = EquivalenceCriterion::NotEquivalent;
+  } else {
+    // the check above ignores the top edge weight, i.e., the global phase
+    const auto w = static_cast<ComplexValue>(e.w);
+    if (std::abs(ComplexNumbers::mag2(e.w) - 1.) > config.tolerance) {
+      result.equivalence = EquivalenceCriterion::NotEquivalent;
+    } else if (std::abs(w.r - 1.) <= config.tolerance &&
+               std::abs(w.i) <= config.tolerance) {
+      result.equivalence = EquivalenceCriterion::Equivalent;
+    } else {
+      result.equivalence = EquivalenceCriterion::EquivalentUpToGlobalPhase;
+    }
+  }
+  dd.decRef(e);
+  return result;
+}
+
+template <class Config>
+FalsificationResult
+falsifyEquivalence(const qc::QuantumComputation& qc1,
+                   const qc::QuantumComputation& qc2,
+                   const FalsificationConfiguration& config) {
+  if (qc1.getNqubits() != qc2.getNqubits()) {
+    throw std::invalid_argument(
+        "Equivalence checking requires circuits with the same number of "
+        "qubits.");
+  }
+  // only used for validating the circuits
+  static_cast<void>(unitaryOperations(qc1));
+  static_cast<void>(unitaryOperations(qc2));
+
+  const auto nqubits = qc1.getNqubits();
+  const auto stimuli = generateStimuli(
+      nqubits, combine(qc1.ancillary, qc2.ancillary), config);
+  auto nthreads = config.nthreads;
+  if (nthreads == 0U) {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  nthreads = std::max<std::size_t>(1U, std::min(nthreads, stimuli.size()));
+
+  // the index of the first stimulus known to distinguish the circuits
+  std::atomic<std::size_t> first = stimuli.size();
+  std::atomic<std::size_t> simulations = 0U;
+  std::atomic<std::size_t> activeNodes = 0U;
+  std::vector<fp> fidelities(stimuli.size(), 1.);
+  const auto search = [&](const std::size_t offset) {
+    const auto dd = std::make_unique<Package<Config>>(nqubits);
+    for (auto i = offset; i < first.load(); i += nthreads) {
+      // simulate() transfers the reference of the input state to the output
+      const auto out1 =
+          simulate(&qc1, dd->makeBasisState(nqubits, stimuli[i]), *dd);
+      const auto out2 =
+          simulate(&qc2, dd->makeBasisState(nqubits, stimuli[i]), *dd);
+      fidelities[i] = dd->fidelity(out1, out2);
+      dd->decRef(out1);
+      dd->decRef(out2);
+      dd->garbageCollect();
+      ++simulations;
+
+      if (fidelities[i] < config.fidelityThreshold) {
+        auto expected = first.load();
+        while (i < expected && !first.compare_exchange_weak(expected, i)) {
+        }
+        break;
+      }
+    }
+    activeNodes += dd->vUniqueTable.getNumActiveEntries();
+  };
+
+  std::vector<std::future<void>> futures{};
+  futures.reserve(nthreads);
+  for (std::size_t t = 0U; t < nthreads; ++t) {
+    futures.emplace_back(std::async(std::launch::async, search, t));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  FalsificationResult result{};
+  result.simulations = simulations.load();
+  result.activeNodes = activeNodes.load();
+  if (const auto i = first.load(); i < stimuli.size()) {
+    result.falsified = true;
+    result.counterexample = stimuli[i];
+    result.fidelity = fidelities[i];
+  }
+  return result;
+}
+
+template EquivalenceCheckingResult
+checkEquivalence(const qc::QuantumComputation& qc1,
+                 const qc::QuantumComputation& qc2,
+                 Package<DDPackageConfig>& dd,
+                 const EquivalenceCheckingConfiguration& config);
+
+template FalsificationResult
+falsifyEquivalence<DDPackageConfig>(const qc::QuantumComputation& qc1,
+                                    const qc::QuantumComputation& qc2,
+                                    const FalsificationConfiguration& config);
+
+} // namespace dd
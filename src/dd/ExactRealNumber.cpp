@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/ExactRealNumber.hpp"
+
+#include "Definitions.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/RealNumber.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <utility>
+
+namespace dd {
+
+namespace {
+constexpr long double SQRT2_L =
+    1.414213562373095048801688724209698078569671875376948073176L;
+
+/// Numbers beyond this magnitude are never recognized (avoids overflows)
+constexpr fp MAX_RECOGNIZABLE_VALUE = 1e6;
+
+/// The Lovász constant of the lattice reduction
+constexpr long double LLL_DELTA = 0.99L;
+/// Bound on the number of reduction steps (only reached for degenerate input)
+constexpr std::size_t MAX_LLL_STEPS = 1000U;
+/// Bound on intermediate coefficients (only reached for degenerate input)
+constexpr long double MAX_LLL_COEFFICIENT = 1e15L;
+
+/// Coefficients (n, -a, -b) of a relation n * val - a - b√2
+using Relation = std::array<std::int64_t, 3>;
+
+/**
+ * @brief Lattice reduction of the lattice spanned by the rows of
+ * [I | s * (val, 1, √2)^T]
+ * @details Every lattice vector corresponds to a relation and is short iff
+ * the coefficients as well as the residual are small. The weight s of the
+ * residual n * val - a - b√2 is the inverse of the recognition tolerance.
+ * Since the lattice is three-dimensional, all Gram-Schmidt data is simply
+ * recomputed after each modification of the basis.
+ */
+class RelationLattice {
+public:
+  RelationLattice(const fp val, const long double tolerance)
+      : x(val), scale(1.L / tolerance) {}
+
+  /// Reduce the basis. Returns false if the reduction did not terminate.
+  bool reduce() {
+    std::size_t k = 1U;
+    for (std::size_t steps = 0U; k < basis.size(); ++steps) {
+      if (steps == MAX_LLL_STEPS) {
+        return false;
+      }
+      orthogonalize();
+      for (std::size_t j = k; j-- > 0U;) {
+        const auto factor = std::round(mu[k][j]);
+        if (factor == 0.L) {
+          continue;
+        }
+        if (std::abs(factor) > MAX_LLL_COEFFICIENT) {
+          return false;
+        }
+        const auto q = static_cast<std::int64_t>(factor);
+        for (std::size_t i = 0U; i < basis[k].size(); ++i) {
+          basis[k][i] -= q * basis[j][i];
+          if (std::abs(static_cast<long double>(basis[k][i])) >
+              MAX_LLL_COEFFICIENT) {
+            return false;
+          }
+        }
+        orthogonalize();
+      }
+      if (norms[k] >= (LLL_DELTA - (mu[k][k - 1] * mu[k][k - 1])) *
+                          norms[k - 1]) {
+        ++k;
+      } else {
+        std::swap(basis[k], basis[k - 1]);
+        k = std::max<std::size_t>(k - 1U, 1U);
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] const std::array<Relation, 3>& getBasis() const noexcept {
+    return basis;
+  }
+
+  /// The residual n * val - a - b√2 of a relation
+  [[nodiscard]] long double residual(const Relation& r) const noexcept {
+    return (static_cast<long double>(r[0]) * x) +
+           static_cast<long double>(r[1]) +
+           (static_cast<long double>(r[2]) * SQRT2_L);
+  }
+
+private:
+  long double x;
+  long double scale;
+  std::array<Relation, 3> basis{{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+  std::array<std::array<long double, 3>, 3> mu{};
+  std::array<long double, 3> norms{};
+
+  [[nodiscard]] long double dot(const Relation& lhs,
+                                const Relation& rhs) const noexcept {
+    long double result = scale * scale * residual(lhs) * residual(rhs);
+    for (std::size_t i = 0U; i < lhs.size(); ++i) {
+      result += static_cast<long double>(lhs[i]) *
+                static_cast<long double>(rhs[i]);
+    }
+    return result;
+  }
+
+  void orthogonalize() noexcept {
+    for (std::size_t i = 0U; i < basis.size(); ++i) {
+      norms[i] = dot(basis[i], basis[i]);
+      for (std::size_t j = 0U; j < i; ++j) {
+        mu[i][j] = dot(basis[i], basis[j]);
+        for (std::size_t l = 0U; l < j; ++l) {
+          mu[i][j] -= mu[j][l] * mu[i][l] * norms[l];
+        }
+        mu[i][j] /= norms[j];
+        norms[i] -= mu[i][j] * mu[i][j] * norms[j];
+      }
+    }
+  }
+};
+} // namespace
+
+void RationalSqrt2::canonicalize() noexcept {
+  if (n < 0) {
+    a = -a;
+    b = -b;
+    n = -n;
+  }
+  const auto divisor = std::gcd(std::gcd(a, b), n);
+  if (divisor > 1) {
+    a /= divisor;
+    b /= divisor;
+    n /= divisor;
+  }
+}
+
+fp RationalSqrt2::value() const noexcept {
+  const auto numerator =
+      static_cast<long double>(a) + (static_cast<long double>(b) * SQRT2_L);
+  return static_cast<fp>(numerator / static_cast<long double>(n));
+}
+
+std::optional<RationalSqrt2> RationalSqrt2::recognize(const fp val) noexcept {
+  if (std::abs(val) > MAX_RECOGNIZABLE_VALUE) {
+    return std::nullopt;
+  }
+  const auto tolerance =
+      static_cast<long double>(RECOGNITION_TOLERANCE_FACTOR * RealNumber::eps);
+  RelationLattice lattice(val, tolerance);
+  if (!lattice.reduce()) {
+    return std::nullopt;
+  }
+  // the reduced basis is ordered (roughly) by length
+  for (const auto& relation : lattice.getBasis()) {
+    if (relation[0] == 0 ||
+        std::any_of(relation.begin(), relation.end(), [](const auto c) {
+          return c > MAX_COEFFICIENT || c < -MAX_COEFFICIENT;
+        })) {
+      continue;
+    }
+    const auto deviation = std::abs(lattice.residual(relation) /
+                                    static_cast<long double>(relation[0]));
+    if (deviation <= tolerance) {
+      RationalSqrt2 result{-relation[1], -relation[2], relation[0]};
+      result.canonicalize();
+      return result;
+    }
+  }
+  return std::nullopt;
+}
+
+std::ostream& operator<<(std::ostream& os, const RationalSqrt2& x) {
+  return os << "(" << x.a << " + " << x.b << "√2) / " << x.n;
+}
+
+std::size_t
+ExactRealNumberTable::Hash::operator()(const RationalSqrt2& x) const noexcept {
+  auto h = qc::murmur64(static_cast<std::uint64_t>(x.a));
+  qc::hashCombine(h, qc::murmur64(static_cast<std::uint64_t>(x.b)));
+  qc::hashCombine(h, qc::murmur64(static_cast<std::uint64_t>(x.n)));
+  return h;
+}
+
+RealNumber* ExactRealNumberTable::find(const RationalSqrt2& x) const {
+  if (const auto it = table.find(x); it != table.end()) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+void ExactRealNumberTable::insert(const RationalSqrt2& x, RealNumber* entry) {
+  table[x] = entry;
+}
+
+std::size_t ExactRealNumberTable::garbageCollect() noexcept {
+  std::size_t collected = 0U;
+  for (auto it = table.begin(); it != table.end();) {
+    if (RealNumber::refCount(it->second) == 0U) {
+      it = table.erase(it);
+      ++collected;
+    } else {
+      ++it;
+    }
+  }
+  return collected;
+}
+
+} // namespace dd
@@ -9,16 +9,52 @@
 
 #include "dd/FunctionalityConstruction.hpp"
 
+#include "dd/Node.hpp"
 #include "dd/Package.hpp"
+#include "dd/Reordering.hpp"
+#include "dd/StaticOrdering.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/OpType.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
 #include <stack>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace dd {
+namespace {
+/// Run all tasks concurrently and rethrow the first exception (if any)
+void runConcurrently(const std::vector<std::function<void()>>& tasks) {
+  std::vector<std::exception_ptr> errors(tasks.size());
+  std::vector<std::thread> threads{};
+  threads.reserve(tasks.size());
+  for (std::size_t i = 0U; i < tasks.size(); ++i) {
+    threads.emplace_back([&tasks, &errors, i]() {
+      try {
+        tasks[i]();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+} // namespace
+
 template <class Config>
 MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd) {
   if (qc->getNqubits() == 0U) {
@@ -33,6 +69,7 @@ MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd) {
     if (op->getType() == OpType::SWAP && !op->isControlled()) {
       const auto& targets = op->getTargets();
       std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
+      dd.template recordSize<mNode>(op->getName());
       continue;
     }
 
@@ -46,6 +83,67 @@ MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd) {
   return e;
 }
 
+template <class Config>
+MatrixDD buildFunctionality(const QuantumComputation* qc, Package<Config>& dd,
+                            const DynamicReordering& strategy,
+                            ReorderingMetadata& metadata) {
+  if (qc->getNqubits() == 0U || !strategy.enabled()) {
+    return buildFunctionality(qc, dd);
+  }
+
+  auto threshold = strategy.threshold;
+  auto permutation = qc->initialLayout;
+  // reordering exchanges levels on both sides of the matrix, while SWAP gates
+  // only permute its outputs
+  auto inputPermutation = qc->initialLayout;
+  auto e = dd.createInitialMatrix(qc->ancillary);
+  if (strategy.staticOrder) {
+    // move the inputs and outputs to their proposed levels
+    const auto order = proposeQubitOrder(*qc);
+    changePermutation(e, inputPermutation, order, dd, false);
+    changePermutation(e, permutation, order, dd);
+  }
+
+  std::size_t applied = 0U;
+  for (const auto& op : *qc) {
+    // SWAP gates can be executed virtually by changing the permutation
+    if (op->getType() == OpType::SWAP && !op->isControlled()) {
+      const auto& targets = op->getTargets();
+      std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
+      dd.template recordSize<mNode>(op->getName());
+      continue;
+    }
+
+    e = applyUnitaryOperation(op.get(), e, dd, permutation);
+    ++applied;
+    if (strategy.dynamicEnabled() && strategy.checkDue(applied) &&
+        dd.exceedsSize(e, threshold)) {
+      const auto before = permutation;
+      const auto size = reorder(e, permutation, dd, strategy, metadata);
+      threshold = std::max(threshold,
+                           static_cast<std::size_t>(static_cast<fp>(size) *
+                                                    strategy.thresholdGrowth));
+      // move the inputs along with the outputs
+      std::map<qc::Qubit, qc::Qubit> moved{};
+      for (const auto& [qubit, level] : before) {
+        moved[level] = permutation.at(qubit);
+      }
+      for (auto& [qubit, level] : inputPermutation) {
+        if (const auto it = moved.find(level); it != moved.end()) {
+          level = it->second;
+        }
+      }
+    }
+  }
+  // correct permutations if necessary
+  changePermutation(e, inputPermutation, qc->initialLayout, dd, false);
+  changePermutation(e, permutation, qc->outputPermutation, dd);
+  e = dd.reduceAncillae(e, qc->ancillary);
+  e = dd.reduceGarbage(e, qc->garbage);
+
+  return e;
+}
+
 template <class Config>
 MatrixDD buildFunctionalityRecursive(const QuantumComputation* qc,
                                      Package<Config>& dd) {
@@ -141,6 +239,101 @@ bool buildFunctionalityRecursive(const QuantumComputation* qc,
   return success;
 }
 
+template <class Config>
+MatrixDD buildFunctionalityParallel(const QuantumComputation* qc,
+                                    Package<Config>& dd, std::size_t nthreads) {
+  if (qc->getNqubits() == 0U) {
+    return MatrixDD::one();
+  }
+
+  if (nthreads == 0U) {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  const auto nops = qc->size();
+  const auto nranges = std::min(nthreads, nops);
+  if (nranges <= 1U) {
+    return buildFunctionality(qc, dd);
+  }
+
+  // split the circuit into contiguous ranges of operations and determine the
+  // permutation at the start of each range
+  std::vector<std::size_t> bounds(nranges + 1U);
+  for (std::size_t r = 0U; r <= nranges; ++r) {
+    bounds[r] = (r * nops) / nranges;
+  }
+  auto permutation = qc->initialLayout;
+  std::vector<Permutation> permutations{};
+  permutations.reserve(nranges);
+  for (std::size_t r = 0U; r < nranges; ++r) {
+    permutations.emplace_back(permutation);
+    for (auto i = bounds[r]; i < bounds[r + 1U]; ++i) {
+      if (const auto& op = qc->at(i);
+          op->getType() == OpType::SWAP && !op->isControlled()) {
+        const auto& targets = op->getTargets();
+        std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
+      }
+    }
+  }
+
+  // build the functionality of each range in a separate package
+  std::vector<std::unique_ptr<Package<Config>>> packages(nranges);
+  std::vector<MatrixDD> results(nranges);
+  std::vector<std::function<void()>> tasks{};
+  tasks.reserve(nranges);
+  for (std::size_t r = 0U; r < nranges; ++r) {
+    tasks.emplace_back([&, r]() {
+      packages[r] = std::make_unique<Package<Config>>(dd.qubits());
+      auto& local = *packages[r];
+      auto perm = permutations[r];
+      auto e = local.makeIdent();
+      local.incRef(e);
+      for (auto i = bounds[r]; i < bounds[r + 1U]; ++i) {
+        const auto& op = qc->at(i);
+        // SWAP gates can be executed virtually by changing the permutation
+        if (op->getType() == OpType::SWAP && !op->isControlled()) {
+          const auto& targets = op->getTargets();
+          std::swap(perm.at(targets[0U]), perm.at(targets[1U]));
+          continue;
+        }
+        e = applyUnitaryOperation(op.get(), e, local, perm);
+      }
+      results[r] = e;
+    });
+  }
+  runConcurrently(tasks);
+
+  // combine the partial results in a balanced tree. Each product is computed in
+  // the package of the earlier range, into which the later result is
+  // transferred. Products on the same level of the tree are independent.
+  for (std::size_t stride = 1U; stride < nranges; stride *= 2U) {
+    tasks.clear();
+    for (std::size_t r = 0U; r + stride < nranges; r += 2U * stride) {
+      tasks.emplace_back([&, r, stride]() {
+        auto& local = *packages[r];
+        const auto later = local.transfer(results[r + stride]);
+        packages[r + stride].reset();
+        const auto product = local.multiply(later, results[r]);
+        local.incRef(product);
+        local.decRef(results[r]);
+        local.garbageCollect();
+        results[r] = product;
+      });
+    }
+    runConcurrently(tasks);
+  }
+
+  auto e = dd.transfer(results.front());
+  packages.front().reset();
+  dd.incRef(e);
+
+  // correct permutation if necessary
+  changePermutation(e, permutation, qc->outputPermutation, dd);
+  e = dd.reduceAncillae(e, qc->ancillary);
+  e = dd.reduceGarbage(e, qc->garbage);
+
+  return e;
+}
+
 template MatrixDD buildFunctionality(const qc::QuantumComputation* qc,
                                      Package<DDPackageConfig>& dd);
 template MatrixDD
@@ -152,6 +345,13 @@ buildFunctionality(const qc::QuantumComputation* qc,
 
 template MatrixDD buildFunctionality(const qc::QuantumComputation* qc,
                                      UnitarySimulatorDDPackage& dd);
+template MatrixDD buildFunctionality(const qc::QuantumComputation* qc,
+                                     CliffordTDDPackage& dd);
+
+template MatrixDD buildFunctionality(const qc::QuantumComputation* qc,
+                                     Package<DDPackageConfig>& dd,
+                                     const DynamicReordering& strategy,
+                                     ReorderingMetadata& metadata);
 
 template MatrixDD buildFunctionalityRecursive(const qc::QuantumComputation* qc,
                                               Package<DDPackageConfig>& dd);
@@ -169,4 +369,10 @@ template bool buildFunctionalityRecursive(const qc::QuantumComputation* qc,
                                           std::stack<MatrixDD>& s,
                                           qc::Permutation& permutation,
                                           UnitarySimulatorDDPackage& dd);
+template MatrixDD buildFunctionalityParallel(const qc::QuantumComputation* qc,
+                                             Package<DDPackageConfig>& dd,
+                                             std::size_t nthreads);
+template MatrixDD buildFunctionalityParallel(const qc::QuantumComputation* qc,
+                                             UnitarySimulatorDDPackage& dd,
+                                             std::size_t nthreads);
 } // namespace dd
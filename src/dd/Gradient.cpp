@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/Gradient.hpp"
+
+#include "dd/ComplexValue.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/DDpackageConfig.hpp"
+#include "dd/Node.hpp"
+#include "dd/Operations.hpp"
+#include "dd/Package.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Expression.hpp"
+#include "ir/operations/OpType.hpp"
+#include "ir/operations/Operation.hpp"
+#include "ir/operations/StandardOperation.hpp"
+#include "ir/operations/SymbolicOperation.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dd {
+
+namespace {
+/**
+ * @brief The parameter-shift rule of a gate parameter
+ * @return The shift s and the factor c such that
+ * dU/dθ = c·(U(θ + s) - U(θ - s))
+ */
+std::pair<fp, fp> shiftRule(const qc::OpType type, const std::size_t param) {
+  switch (type) {
+  // the matrix depends on θ/2
+  case qc::RX:
+  case qc::RY:
+  case qc::RZ:
+  case qc::RXX:
+  case qc::RYY:
+  case qc::RZZ:
+  case qc::RZX:
+    return {PI, 0.25};
+  case qc::U:
+  case qc::XXminusYY:
+  case qc::XXplusYY:
+    if (param == 0U) {
+      return {PI, 0.25};
+    }
+    return {PI_2, 0.5};
+  // the matrix depends on θ
+  case qc::GPhase:
+  case qc::P:
+  case qc::U2:
+    return {PI_2, 0.5};
+  default:
+    throw std::invalid_argument(
+        "Gradients are not supported for symbolic " + qc::toString(type) +
+        " gates.");
+  }
+}
+
+/// The instantiated operation with the parameter @p shifted moved by @p shift
+qc::StandardOperation instantiate(const qc::SymbolicOperation& op,
+                                  const qc::VariableAssignment& assignment,
+                                  const std::size_t shifted = 0U,
+                                  const fp shift = 0.) {
+  auto parameters = op.getParameters();
+  std::vector<fp> values(parameters.size());
+  for (std::size_t i = 0U; i < parameters.size(); ++i) {
+    if (const auto* expr = std::get_if<qc::Symbolic>(&parameters[i]);
+        expr != nullptr) {
+      values[i] = expr->evaluate(assignment);
+    } else {
+      values[i] = std::get<fp>(parameters[i]);
+    }
+  }
+  values.at(shifted) += shift;
+  return {op.getControls(), op.getTargets(), op.getType(), values};
+}
+
+/// The symbolic operations of a circuit (nullptr for all other operations)
+std::vector<const qc::SymbolicOperation*>
+symbolicOperations(const qc::QuantumComputation& qc,
+                   const qc::VariableAssignment& assignment) {
+  std::vector<const qc::SymbolicOperation*> result(qc.size(), nullptr);
+  for (std::size_t i = 0U; i < qc.size(); ++i) {
+    const auto& op = qc.at(i);
+    if (!op->isUnitary()) {
+      throw std::invalid_argument(
+          "Gradients require unitary circuits, but the circuit contains the "
+          "non-unitary operation " +
+          op->getName() + ".");
+    }
+    if (!op->isSymbolicOperation()) {
+      continue;
+    }
+    const auto* symOp = dynamic_cast<const qc::SymbolicOperation*>(op.get());
+    if (symOp == nullptr) {
+      throw std::invalid_argument("Gradients do not support symbolic "
+                                  "parameters in compound operations.");
+    }
+    const auto parameters = symOp->getParameters();
+    for (std::size_t j = 0U; j < parameters.size(); ++j) {
+      if (const auto* expr = std::get_if<qc::Symbolic>(&parameters[j]);
+          expr != nullptr) {
+        // fail before the simulation if the gate is not supported
+        static_cast<void>(shiftRule(symOp->getType(), j));
+        for (const auto& term : *expr) {
+          if (assignment.find(term.getVar()) == assignment.end()) {
+            throw std::invalid_argument("No value given for the variable " +
+                                        term.getVar().getName() + ".");
+          }
+        }
+      }
+    }
+    result[i] = symOp;
+  }
+  return result;
+}
+
+bool isVirtualSwap(const qc::Operation* op) {
+  return op->getType() == qc::SWAP && !op->isControlled();
+}
+} // namespace
+
+template <class Config>
+GradientResult computeGradient(const qc::QuantumComputation& qc,
+                               const vEdge& in, const mEdge& observable,
+                               const qc::VariableAssignment& assignment,
+                               Package<Config>& dd) {
+  const auto symbolic = symbolicOperations(qc, assignment);
+
+  // forward simulation
+  auto permutation = qc.initialLayout;
+  auto psi = in;
+  dd.incRef(psi);
+  for (std::size_t i = 0U; i < qc.size(); ++i) {
+    const auto* op = qc.at(i).get();
+    if (isVirtualSwap(op)) {
+      const auto& targets = op->getTargets();
+      std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
+      continue;
+    }
+    if (symbolic[i] != nullptr) {
+      const auto instantiated = instantiate(*symbolic[i], assignment);
+      psi = applyUnitaryOperation(&instantiated, psi, dd, permutation);
+    } else {
+      psi = applyUnitaryOperation(op, psi, dd, permutation);
+    }
+  }
+
+  // the adjoint state H|ψ> with respect to the output permutation, moved back
+  // to the levels of the simulated state
+  GradientResult result{};
+  auto out = psi;
+  dd.incRef(out);
+  auto reached = permutation;
+  changePermutation(out, reached, qc.outputPermutation, dd);
+  result.expectationValue = dd.expectationValue(observable, out);
+  auto lambda = dd.multiply(observable, out);
+  dd.incRef(lambda);
+  dd.decRef(out);
+  changePermutation(lambda, reached, permutation, dd);
+
+  // backward propagation of both states
+  for (auto i = qc.size(); i-- > 0U;) {
+    const auto* op = qc.at(i).get();
+    if (isVirtualSwap(op)) {
+      const auto& targets = op->getTargets();
+      std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
+      continue;
+    }
+    if (symbolic[i] == nullptr) {
+      // the inverse has to survive the garbage collection of the first update
+      const auto inverse = getInverseDD(op, dd, permutation);
+      dd.incRef(inverse);
+      psi = dd.applyOperation(inverse, psi);
+      lambda = dd.applyOperation(inverse, lambda);
+      dd.decRef(inverse);
+      continue;
+    }
+
+    const auto& symOp = *symbolic[i];
+    const auto instantiated = instantiate(symOp, assignment);
+    const auto inverse = getInverseDD(&instantiated, dd, permutation);
+    dd.incRef(inverse);
+    psi = dd.applyOperation(inverse, psi);
+    const auto parameters = symOp.getParameters();
+    for (std::size_t j = 0U; j < parameters.size(); ++j) {
+      const auto* expr = std::get_if<qc::Symbolic>(&parameters[j]);
+      if (expr == nullptr) {
+        continue;
+      }
+      // dE/dθ = 2·Re(<λ|dU/dθ|ψ>)
+      const auto [shift, factor] = shiftRule(symOp.getType(), j);
+      const auto plus = instantiate(symOp, assignment, j, shift);
+      const auto minus = instantiate(symOp, assignment, j, -shift);
+      const ComplexValue forward = dd.innerProduct(
+          lambda, dd.multiply(getDD(&plus, dd, permutation), psi));
+      const ComplexValue backward = dd.innerProduct(
+          lambda, dd.multiply(getDD(&minus, dd, permutation), psi));
+      const auto derivative = 2. * factor * (forward.r - backward.r);
+      for (const auto& term : *expr) {
+        result.gradient[term.getVar()] += term.getCoeff() * derivative;
+      }
+    }
+    lambda = dd.applyOperation(inverse, lambda);
+    dd.decRef(inverse);
+  }
+  dd.decRef(psi);
+  dd.decRef(lambda);
+  return result;
+}
+
+template GradientResult
+computeGradient(const qc::QuantumComputation& qc, const vEdge& in,
+                const mEdge& observable,
+                const qc::VariableAssignment& assignment,
+                Package<DDPackageConfig>& dd);
+
+} // namespace dd
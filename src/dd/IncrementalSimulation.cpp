@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/IncrementalSimulation.hpp"
+
+#include "dd/DDpackageConfig.hpp"
+#include "dd/Node.hpp"
+#include "dd/Operations.hpp"
+#include "dd/Package.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Expression.hpp"
+#include "ir/operations/OpType.hpp"
+#include "ir/operations/SymbolicOperation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace dd {
+
+template <class Config>
+IncrementalSimulator<Config>::IncrementalSimulator(
+    const qc::QuantumComputation& circuit, const vEdge& in,
+    Package<Config>& package, const std::size_t checkpointInterval)
+    : qc(&circuit), dd(&package), interval(checkpointInterval) {
+  if (interval == 0U) {
+    interval = std::max<std::size_t>(
+        1U, static_cast<std::size_t>(
+                std::ceil(std::sqrt(static_cast<double>(qc->size())))));
+  }
+  for (std::size_t i = 0U; i < qc->size(); ++i) {
+    const auto& op = qc->at(i);
+    if (!op->isUnitary()) {
+      throw std::invalid_argument(
+          "Incremental simulation requires unitary circuits, but the circuit "
+          "contains the non-unitary operation " +
+          op->getName() + ".");
+    }
+    if (!op->isSymbolicOperation()) {
+      continue;
+    }
+    const auto* symOp = dynamic_cast<const qc::SymbolicOperation*>(op.get());
+    if (symOp == nullptr) {
+      throw std::invalid_argument(
+          "Incremental simulation does not support symbolic parameters in "
+          "compound operations.");
+    }
+    for (const auto& param : symOp->getParameters()) {
+      if (const auto* expr = std::get_if<qc::Symbolic>(&param);
+          expr != nullptr) {
+        for (const auto& term : *expr) {
+          firstUse.try_emplace(term.getVar(), i);
+        }
+      }
+    }
+  }
+
+  dd->incRef(in);
+  checkpoints.push_back({in, qc->initialLayout});
+}
+
+template <class Config> IncrementalSimulator<Config>::~IncrementalSimulator() {
+  for (const auto& checkpoint : checkpoints) {
+    dd->decRef(checkpoint.state);
+  }
+}
+
+template <class Config>
+std::size_t IncrementalSimulator<Config>::firstAffected(
+    const qc::VariableAssignment& assignment) const {
+  if (!previous.has_value()) {
+    return 0U;
+  }
+  auto first = qc->size();
+  for (const auto& [var, index] : firstUse) {
+    if (previous->at(var) != assignment.at(var)) {
+      first = std::min(first, index);
+    }
+  }
+  return first;
+}
+
+template <class Config>
+vEdge IncrementalSimulator<Config>::simulate(
+    const qc::VariableAssignment& assignment) {
+  for (const auto& [var, index] : firstUse) {
+    if (assignment.find(var) == assignment.end()) {
+      throw std::invalid_argument("No value given for the variable " +
+                                  var.getName() + ".");
+    }
+  }
+
+  // resume from the last checkpoint before the first affected operation
+  const auto k =
+      std::min(firstAffected(assignment) / interval, checkpoints.size() - 1U);
+  while (checkpoints.size() > k + 1U) {
+    dd->decRef(checkpoints.back().state);
+    checkpoints.pop_back();
+  }
+  auto e = checkpoints.back().state;
+  dd->incRef(e);
+  auto permutation = checkpoints.back().permutation;
+  const auto start = k * interval;
+  for (auto i = start; i < qc->size(); ++i) {
+    if (i % interval == 0U && i / interval == checkpoints.size()) {
+      dd->incRef(e);
+      checkpoints.push_back({e, permutation});
+    }
+    const auto* op = qc->at(i).get();
+    // SWAP gates can be executed virtually by changing the permutation
+    if (op->getType() == qc::SWAP && !op->isControlled()) {
+      const auto& targets = op->getTargets();
+      std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
+      continue;
+    }
+    if (op->isSymbolicOperation()) {
+      const auto instantiated =
+          dynamic_cast<const qc::SymbolicOperation*>(op)
+              ->getInstantiatedOperation(assignment);
+      e = applyUnitaryOperation(&instantiated, e, *dd, permutation);
+    } else {
+      e = applyUnitaryOperation(op, e, *dd, permutation);
+    }
+  }
+  applied = qc->size() - start;
+  previous = assignment;
+
+  changePermutation(e, permutation, qc->outputPermutation, *dd);
+  return dd->reduceGarbage(e, qc->garbage);
+}
+
+template class IncrementalSimulator<DDPackageConfig>;
+
+} // namespace dd
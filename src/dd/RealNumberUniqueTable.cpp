@@ -10,10 +10,12 @@
 #include "dd/RealNumberUniqueTable.hpp"
 
 #include "dd/DDDefinitions.hpp"
+#include "dd/ExactRealNumber.hpp"
 #include "dd/MemoryManager.hpp"
 #include "dd/RealNumber.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -21,12 +23,21 @@
 #include <iostream>
 #include <limits>
 
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 namespace dd {
 
 RealNumberUniqueTable::RealNumberUniqueTable(MemoryManager<RealNumber>& manager,
                                              const std::size_t initialGCLim)
-    : memoryManager(&manager), initialGCLimit(initialGCLim) {
-  stats.entrySize = sizeof(Bucket);
+    : inlineTable(NBUCKET), memoryManager(&manager),
+      initialGCLimit(initialGCLim) {
+  for (auto& bucket : inlineTable) {
+    bucket.reset();
+  }
+  // every bucket comes with an inline block
+  stats.entrySize = sizeof(Bucket) + sizeof(InlineBucket);
   stats.numBuckets = NBUCKET;
 
   // add 1/2 to the complex table and increase its ref count (so that it is
@@ -67,6 +78,63 @@ void RealNumberUniqueTable::decRef(RealNumber* num) noexcept {
 }
 
 RealNumber* RealNumberUniqueTable::lookupNonNegative(const fp val) {
+  if (!exactLookups) {
+    return lookupApproximately(val);
+  }
+  // numbers are only recognized upon insertion, i.e., any number that is
+  // found within tolerance does not incur any overhead
+  const std::size_t entriesBefore = stats.numEntries;
+  auto* entry = lookupApproximately(val);
+  if (stats.numEntries == entriesBefore) {
+    return entry;
+  }
+  return snapToExact(entry);
+}
+
+RealNumber* RealNumberUniqueTable::snapToExact(RealNumber* entry) {
+  const auto exact = RationalSqrt2::recognize(entry->value);
+  if (!exact) {
+    return entry;
+  }
+  if (auto* existing = exactTable.find(*exact); existing != nullptr) {
+    // the number drifted beyond the tolerance of its exact counterpart
+    remove(entry);
+    ++stats.hits;
+    return existing;
+  }
+  const auto exactValue = exact->value();
+  if (exactValue != entry->value) {
+    remove(entry);
+    entry = lookupApproximately(exactValue);
+  }
+  exactTable.insert(*exact, entry);
+  return entry;
+}
+
+void RealNumberUniqueTable::remove(RealNumber* entry) noexcept {
+  assert(entry->ref == 0U);
+  const auto key = static_cast<std::size_t>(hash(entry->value));
+  RealNumber* prev = nullptr;
+  auto* p = table[key];
+  while (p != nullptr && p != entry) {
+    prev = p;
+    p = p->next;
+  }
+  assert(p == entry);
+  if (prev == nullptr) {
+    table[key] = entry->next;
+  } else {
+    prev->next = entry->next;
+  }
+  if (tailTable[key] == entry) {
+    tailTable[key] = prev;
+  }
+  refreshInlineBucket(key);
+  memoryManager->returnEntry(entry);
+  --stats.numEntries;
+}
+
+RealNumber* RealNumberUniqueTable::lookupApproximately(const fp val) {
   assert(!std::isnan(val));
   assert(val > 0);
 
@@ -154,6 +222,7 @@ std::size_t RealNumberUniqueTable::garbageCollect(const bool force) noexcept {
 
   ++stats.gcRuns;
   const auto entryCountBefore = stats.numEntries;
+  exactTable.garbageCollect();
   for (std::size_t key = 0; key < table.size(); ++key) {
     auto* p = table[key];
     RealNumber* lastp = nullptr;
@@ -174,6 +243,7 @@ std::size_t RealNumberUniqueTable::garbageCollect(const bool force) noexcept {
       }
       tailTable[key] = lastp;
     }
+    refreshInlineBucket(key);
   }
   // The garbage collection limit changes dynamically depending on the number
   // of remaining (active) nodes. If it were not changed, garbage collection
@@ -199,6 +269,10 @@ void RealNumberUniqueTable::clear() noexcept {
   for (auto& entry : tailTable) {
     entry = nullptr;
   }
+  for (auto& bucket : inlineTable) {
+    bucket.reset();
+  }
+  exactTable.clear();
   gcLimit = initialGCLimit;
   stats.reset();
 }
@@ -242,9 +316,103 @@ std::ostream& RealNumberUniqueTable::printBucketDistribution(std::ostream& os) {
   return os;
 }
 
+std::size_t
+RealNumberUniqueTable::InlineBucket::find(const fp val) const noexcept {
+  static_assert(INLINE_BUCKET_SIZE == 4U);
+  // differences to the inline values and a bit mask of those within tolerance
+  alignas(32) std::array<fp, INLINE_BUCKET_SIZE> diffs{};
+  unsigned int mask = 0U;
+#if defined(__AVX__)
+  const auto v = _mm256_set1_pd(val);
+  const auto tol = _mm256_set1_pd(RealNumber::eps);
+  const auto sign = _mm256_set1_pd(-0.);
+  const auto d =
+      _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_load_pd(values.data()), v));
+  mask = static_cast<unsigned int>(
+      _mm256_movemask_pd(_mm256_cmp_pd(d, tol, _CMP_LE_OQ)));
+  _mm256_store_pd(diffs.data(), d);
+#elif defined(__SSE2__)
+  const auto v = _mm_set1_pd(val);
+  const auto tol = _mm_set1_pd(RealNumber::eps);
+  const auto sign = _mm_set1_pd(-0.);
+  const auto lo =
+      _mm_andnot_pd(sign, _mm_sub_pd(_mm_load_pd(values.data()), v));
+  const auto hi =
+      _mm_andnot_pd(sign, _mm_sub_pd(_mm_load_pd(values.data() + 2), v));
+  mask = static_cast<unsigned int>(_mm_movemask_pd(_mm_cmple_pd(lo, tol))) |
+         (static_cast<unsigned int>(_mm_movemask_pd(_mm_cmple_pd(hi, tol)))
+          << 2U);
+  _mm_store_pd(diffs.data(), lo);
+  _mm_store_pd(diffs.data() + 2, hi);
+#else
+  for (std::size_t i = 0U; i < INLINE_BUCKET_SIZE; ++i) {
+    diffs[i] = std::abs(values[i] - val);
+    if (diffs[i] <= RealNumber::eps) {
+      mask |= 1U << i;
+    }
+  }
+#endif
+  if (mask == 0U) {
+    return INLINE_BUCKET_SIZE;
+  }
+  // the entries of a bucket are more than eps apart, so at most two
+  // (neighbouring) values match. Prefer the smaller one in case of a tie.
+  std::size_t best = INLINE_BUCKET_SIZE;
+  for (std::size_t i = 0U; i < INLINE_BUCKET_SIZE; ++i) {
+    if (((mask >> i) & 1U) != 0U &&
+        (best == INLINE_BUCKET_SIZE || diffs[i] < diffs[best])) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+bool RealNumberUniqueTable::InlineBucket::overflows() const noexcept {
+  return entries.back() != nullptr && entries.back()->next != nullptr;
+}
+
+void RealNumberUniqueTable::InlineBucket::reset() noexcept {
+  // a value that is never within tolerance of any (non-negative) lookup.
+  // Infinity is avoided since it is not supported with fast-math.
+  values.fill(std::numeric_limits<fp>::max());
+  entries.fill(nullptr);
+}
+
+void RealNumberUniqueTable::refreshInlineBucket(
+    const std::size_t key) noexcept {
+  auto& bucket = inlineTable[key];
+  bucket.reset();
+  auto* p = table[key];
+  for (std::size_t i = 0U; i < INLINE_BUCKET_SIZE && p != nullptr; ++i) {
+    bucket.values[i] = p->value;
+    bucket.entries[i] = p;
+    p = p->next;
+  }
+}
+
 RealNumber* RealNumberUniqueTable::findOrInsert(const std::int64_t key,
                                                 const fp val) {
   const auto k = static_cast<std::size_t>(key);
+  const auto& bucket = inlineTable[k];
+  const auto i = bucket.find(val);
+  // a match in the last inline slot might still be beaten by the first entry
+  // of the overflow chain
+  if (i + 1U < INLINE_BUCKET_SIZE ||
+      (i + 1U == INLINE_BUCKET_SIZE && !bucket.overflows())) {
+    ++stats.hits;
+    return bucket.entries[i];
+  }
+  const std::size_t entriesBefore = stats.numEntries;
+  auto* entry = findOrInsertInList(key, val);
+  if (stats.numEntries != entriesBefore) {
+    refreshInlineBucket(k);
+  }
+  return entry;
+}
+
+RealNumber* RealNumberUniqueTable::findOrInsertInList(const std::int64_t key,
+                                                      const fp val) {
+  const auto k = static_cast<std::size_t>(key);
   auto* curr = table[k];
   if (curr == nullptr) {
     auto* entry = memoryManager->get();
@@ -327,6 +495,7 @@ RealNumber* RealNumberUniqueTable::insertFront(const std::int64_t key,
   if (curr == nullptr) {
     tailTable[static_cast<std::size_t>(key)] = entry;
   }
+  refreshInlineBucket(static_cast<std::size_t>(key));
   stats.trackInsert();
   return entry;
 }
@@ -344,6 +513,7 @@ RealNumber* RealNumberUniqueTable::insertBack(const std::int64_t key,
   } else {
     back->next = entry;
   }
+  refreshInlineBucket(static_cast<std::size_t>(key));
   stats.trackInsert();
   return entry;
 }
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/Reordering.hpp"
+
+#include "dd/CachedEdge.hpp"
+#include "dd/ComplexValue.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/DDpackageConfig.hpp"
+#include "dd/Edge.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package.hpp"
+#include "ir/Permutation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace dd {
+
+namespace {
+/**
+ * @brief The sub-DD of @p e for the assignment @p i of the qubit at @p level
+ * @details A skipped level of a matrix DD corresponds to the identity.
+ */
+template <class Node>
+CachedEdge<Node> cofactor(const CachedEdge<Node>& e, const Qubit level,
+                          const std::size_t i) {
+  if (e.w.exactlyZero()) {
+    return CachedEdge<Node>::zero();
+  }
+  if (!e.isTerminal() && e.p->v == level) {
+    const auto& s = e.p->e[i];
+    if (s.w.exactlyZero()) {
+      return CachedEdge<Node>::zero();
+    }
+    return {s.p, e.w * s.w};
+  }
+  // only matrix DDs may skip levels
+  assert((std::is_same_v<Node, mNode>));
+  return i == 0U || i == NEDGE - 1U ? e : CachedEdge<Node>::zero();
+}
+
+/**
+ * @brief Exchange the levels @p lower and @p lower + 1 below @p p
+ * @return The rebuilt sub-DD of @p p (relative to the weight of the edge
+ * pointing to @p p)
+ */
+template <class Node, class Config>
+CachedEdge<Node>
+swapLevels(Node* p, const Qubit lower, Package<Config>& dd,
+           std::unordered_map<Node*, CachedEdge<Node>>& cache) {
+  constexpr std::size_t n = std::tuple_size_v<decltype(p->e)>;
+  if (Node::isTerminal(p) || p->v < lower) {
+    return {p, ComplexValue{1.}};
+  }
+  if (const auto it = cache.find(p); it != cache.end()) {
+    return it->second;
+  }
+
+  const auto upper = static_cast<Qubit>(lower + 1U);
+  std::array<CachedEdge<Node>, n> edges{};
+  if (p->v > upper) {
+    for (std::size_t i = 0U; i < n; ++i) {
+      const auto& s = p->e[i];
+      if (s.w.exactlyZero()) {
+        edges[i] = CachedEdge<Node>::zero();
+        continue;
+      }
+      const auto r = swapLevels(s.p, lower, dd, cache);
+      edges[i] = r.w.exactlyZero() ? CachedEdge<Node>::zero()
+                                   : CachedEdge<Node>{r.p, r.w * s.w};
+    }
+  } else {
+    // the sub-DD for the assignments (i, j) of the (upper, lower) qubits is
+    // moved to the assignments (j, i)
+    const CachedEdge<Node> root{p, ComplexValue{1.}};
+    std::array<CachedEdge<Node>, n> uppers{};
+    for (std::size_t i = 0U; i < n; ++i) {
+      uppers[i] = cofactor(root, upper, i);
+    }
+    for (std::size_t j = 0U; j < n; ++j) {
+      std::array<CachedEdge<Node>, n> lowers{};
+      for (std::size_t i = 0U; i < n; ++i) {
+        lowers[i] = cofactor(uppers[i], lower, j);
+      }
+      edges[j] = dd.template makeDDNode<Node, CachedEdge>(lower, lowers);
+    }
+  }
+  const auto r = dd.template makeDDNode<Node, CachedEdge>(
+      std::max(p->v, upper), edges);
+  cache.emplace(p, r);
+  return r;
+}
+
+/**
+ * @brief The number of levels that can be reordered
+ * @details The levels of the DD, restricted to the longest prefix
+ * `0, ..., k - 1` of levels that are covered by the values of @p permutation.
+ * Otherwise, moved levels could not be tracked.
+ */
+template <class Node, class Config>
+std::size_t numLevels(const Edge<Node>& e, const qc::Permutation& permutation,
+                      const Package<Config>& dd) {
+  std::size_t levels = dd.qubits();
+  if constexpr (std::is_same_v<Node, vNode>) {
+    levels = e.isTerminal() ? 0U : static_cast<std::size_t>(e.p->v) + 1U;
+  }
+  std::vector<bool> covered(levels, false);
+  for (const auto& [qubit, level] : permutation) {
+    if (level < levels) {
+      covered[level] = true;
+    }
+  }
+  return static_cast<std::size_t>(
+      std::distance(covered.begin(),
+                    std::find(covered.begin(), covered.end(), false)));
+}
+
+/// The number of nodes on each of the lowest @p levels levels of @p e
+template <class Node>
+std::vector<std::size_t> nodesPerLevel(const Edge<Node>& e,
+                                       const std::size_t levels) {
+  std::vector<std::size_t> nodes(levels, 0U);
+  std::unordered_set<const Node*> visited{};
+  std::vector<const Node*> stack{e.p};
+  while (!stack.empty()) {
+    const auto* p = stack.back();
+    stack.pop_back();
+    if (Node::isTerminal(p) || !visited.emplace(p).second) {
+      continue;
+    }
+    if (p->v < levels) {
+      ++nodes[p->v];
+    }
+    for (const auto& s : p->e) {
+      if (!s.w.exactlyZero()) {
+        stack.emplace_back(s.p);
+      }
+    }
+  }
+  return nodes;
+}
+
+/// Swap two adjacent levels in place and keep track of the moved qubits
+template <class Node, class Config>
+std::size_t swapInPlace(Edge<Node>& e, const Qubit level,
+                        qc::Permutation& permutation, Package<Config>& dd,
+                        ReorderingMetadata& metadata) {
+  const auto swapped = swapAdjacentLevels(e, level, dd);
+  dd.incRef(swapped);
+  dd.decRef(e);
+  dd.garbageCollect();
+  e = swapped;
+
+  for (auto& [qubit, target] : permutation) {
+    if (target == level) {
+      target = level + 1U;
+    } else if (target == level + 1U) {
+      target = level;
+    }
+  }
+  ++metadata.swaps;
+  return e.size();
+}
+} // namespace
+
+template <class Node, class Config>
+Edge<Node> swapAdjacentLevels(const Edge<Node>& e, const Qubit level,
+                              Package<Config>& dd) {
+  if (static_cast<std::size_t>(level) + 1U >= dd.qubits()) {
+    throw std::invalid_argument(
+        "Cannot swap level " + std::to_string(level) + " of a package with " +
+        std::to_string(dd.qubits()) + " qubits.");
+  }
+  if constexpr (std::is_same_v<Node, vNode>) {
+    if (!e.isTerminal() && e.p->v <= level) {
+      throw std::invalid_argument("Cannot swap level " + std::to_string(level) +
+                                  " of a vector DD with " +
+                                  std::to_string(e.p->v + 1U) + " qubits.");
+    }
+  }
+  if (e.isTerminal()) {
+    return e;
+  }
+
+  std::unordered_map<Node*, CachedEdge<Node>> cache{};
+  const auto r = swapLevels(e.p, level, dd, cache);
+  if (r.w.exactlyZero()) {
+    return Edge<Node>::zero();
+  }
+  return dd.cn.lookup(CachedEdge<Node>{r.p, r.w * e.w});
+}
+
+template <class Node, class Config>
+std::size_t sift(Edge<Node>& e, qc::Permutation& permutation,
+                 Package<Config>& dd, ReorderingMetadata& metadata,
+                 const fp maxGrowth) {
+  const auto levels = numLevels(e, permutation, dd);
+  if (levels < 2U) {
+    return e.size();
+  }
+
+  // qubits (identified by their initial level) in order of decreasing number
+  // of nodes on their level
+  const auto nodes = nodesPerLevel(e, levels);
+  std::vector<std::size_t> qubits(levels);
+  std::iota(qubits.begin(), qubits.end(), 0U);
+  std::stable_sort(qubits.begin(), qubits.end(),
+                   [&nodes](const std::size_t lhs, const std::size_t rhs) {
+                     return nodes[lhs] > nodes[rhs];
+                   });
+  // the qubit currently located at each level
+  std::vector<std::size_t> order(levels);
+  std::iota(order.begin(), order.end(), 0U);
+
+  auto best = e.size();
+  for (const auto qubit : qubits) {
+    auto pos = static_cast<std::size_t>(std::distance(
+        order.begin(), std::find(order.begin(), order.end(), qubit)));
+    const auto move = [&](const bool down) {
+      const auto level = down ? pos - 1U : pos;
+      std::swap(order[level], order[level + 1U]);
+      pos = down ? pos - 1U : pos + 1U;
+      return swapInPlace(e, static_cast<Qubit>(level), permutation, dd,
+                         metadata);
+    };
+
+    best = e.size();
+    auto bestPos = pos;
+    const auto downFirst = pos < levels - 1U - pos;
+    for (const auto down : {downFirst, !downFirst}) {
+      while (down ? pos > 0U : pos + 1U < levels) {
+        const auto size = move(down);
+        if (size < best) {
+          best = size;
+          bestPos = pos;
+        } else if (static_cast<fp>(size) > maxGrowth * static_cast<fp>(best)) {
+          break;
+        }
+      }
+    }
+    while (pos != bestPos) {
+      move(pos > bestPos);
+    }
+  }
+  return e.size();
+}
+
+template <class Node, class Config>
+std::size_t windowPermutation(Edge<Node>& e, qc::Permutation& permutation,
+                              Package<Config>& dd,
+                              ReorderingMetadata& metadata) {
+  const auto levels = numLevels(e, permutation, dd);
+  auto best = e.size();
+  for (auto improved = levels >= 2U; improved;) {
+    improved = false;
+    for (std::size_t l = 0U; l + 1U < levels; ++l) {
+      const auto lower = static_cast<Qubit>(l);
+      const auto upper = static_cast<Qubit>(l + 1U);
+      // these swaps enumerate all arrangements of the window
+      const auto swaps = l + 2U < levels
+                             ? std::vector{lower, upper, lower, upper, lower}
+                             : std::vector{lower};
+      std::size_t bestStep = 0U;
+      for (std::size_t step = 0U; step < swaps.size(); ++step) {
+        const auto size =
+            swapInPlace(e, swaps[step], permutation, dd, metadata);
+        if (size < best) {
+          best = size;
+          bestStep = step + 1U;
+        }
+      }
+      // undo the swaps performed after the best arrangement
+      for (auto step = swaps.size(); step > bestStep; --step) {
+        swapInPlace(e, swaps[step - 1U], permutation, dd, metadata);
+      }
+      improved = improved || bestStep != 0U;
+    }
+  }
+  return e.size();
+}
+
+template <class Node, class Config>
+std::size_t reorder(Edge<Node>& e, qc::Permutation& permutation,
+                    Package<Config>& dd, const DynamicReordering& strategy,
+                    ReorderingMetadata& metadata) {
+  const auto before = e.size();
+  auto after = before;
+  switch (strategy.method) {
+  case ReorderingMethod::Sifting:
+    after = sift(e, permutation, dd, metadata, strategy.maxGrowth);
+    break;
+  case ReorderingMethod::Window:
+    after = windowPermutation(e, permutation, dd, metadata);
+    break;
+  default:
+    return before;
+  }
+  ++metadata.rounds;
+  if (after < before) {
+    metadata.removedNodes += before - after;
+  }
+  return after;
+}
+
+template vEdge swapAdjacentLevels(const vEdge& e, Qubit level,
+                                  Package<DDPackageConfig>& dd);
+template mEdge swapAdjacentLevels(const mEdge& e, Qubit level,
+                                  Package<DDPackageConfig>& dd);
+template std::size_t sift(vEdge& e, qc::Permutation& permutation,
+                          Package<DDPackageConfig>& dd,
+                          ReorderingMetadata& metadata, fp maxGrowth);
+template std::size_t sift(mEdge& e, qc::Permutation& permutation,
+                          Package<DDPackageConfig>& dd,
+                          ReorderingMetadata& metadata, fp maxGrowth);
+template std::size_t windowPermutation(vEdge& e, qc::Permutation& permutation,
+                                       Package<DDPackageConfig>& dd,
+                                       ReorderingMetadata& metadata);
+template std::size_t windowPermutation(mEdge& e, qc::Permutation& permutation,
+                                       Package<DDPackageConfig>& dd,
+                                       ReorderingMetadata& metadata);
+template std::size_t reorder(vEdge& e, qc::Permutation& permutation,
+                             Package<DDPackageConfig>& dd,
+                             const DynamicReordering& strategy,
+                             ReorderingMetadata& metadata);
+template std::size_t reorder(mEdge& e, qc::Permutation& permutation,
+                             Package<DDPackageConfig>& dd,
+                             const DynamicReordering& strategy,
+                             ReorderingMetadata& metadata);
+} // namespace dd
@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/Serialization.hpp"
+
+#include "Definitions.hpp"
+#include "dd/Complex.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/DDpackageConfig.hpp"
+#include "dd/Edge.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package.hpp"
+#include "dd/RealNumber.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MQT_CORE_DD_USE_MMAP 1
+#endif
+
+namespace dd {
+
+namespace {
+constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+/// 64-bit FNV-1a hash of the given bytes (continuing from @p h)
+std::uint64_t fnv1a(const char* data, const std::size_t size,
+                    std::uint64_t h = FNV_OFFSET_BASIS) {
+  for (std::size_t i = 0U; i < size; ++i) {
+    h ^= static_cast<std::uint8_t>(data[i]);
+    h *= FNV_PRIME;
+  }
+  return h;
+}
+
+/// Sequentially appends values to a byte buffer
+class PayloadWriter {
+public:
+  template <class T> void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    buffer.append(bytes, sizeof(T));
+  }
+
+  void writeVarint(std::uint64_t value) {
+    while (value >= 0x80U) {
+      buffer.push_back(static_cast<char>((value & 0x7FU) | 0x80U));
+      value >>= 7U;
+    }
+    buffer.push_back(static_cast<char>(value));
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return buffer.size(); }
+  [[nodiscard]] const std::string& data() const noexcept { return buffer; }
+
+private:
+  std::string buffer;
+};
+
+/// Sequentially reads values from a byte buffer with bounds checking
+class PayloadReader {
+public:
+  PayloadReader(const char* data, const std::size_t size)
+      : end(data + size), pos(data) {}
+
+  template <class T> T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (static_cast<std::size_t>(end - pos) < sizeof(T)) {
+      throw std::runtime_error("Compact serialization is truncated.");
+    }
+    T value{};
+    std::memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+  }
+
+  std::uint64_t readVarint() {
+    std::uint64_t value = 0U;
+    for (unsigned shift = 0U; shift < 64U; shift += 7U) {
+      const auto byte = read<std::uint8_t>();
+      value |= static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+      if ((byte & 0x80U) == 0U) {
+        return value;
+      }
+    }
+    throw std::runtime_error("Compact serialization contains invalid varint.");
+  }
+
+  /// Return a reader for the next @p size bytes and skip them
+  PayloadReader section(const std::size_t size) {
+    if (static_cast<std::size_t>(end - pos) < size) {
+      throw std::runtime_error("Compact serialization is truncated.");
+    }
+    PayloadReader r{pos, size};
+    pos += size;
+    return r;
+  }
+
+  [[nodiscard]] bool atEnd() const noexcept { return pos == end; }
+
+private:
+  const char* end;
+  const char* pos;
+};
+
+/// Reads the entries of a column of the node table
+class ColumnReader {
+public:
+  ColumnReader(PayloadReader r, const bool isCompressed)
+      : reader(r), compressed(isCompressed) {}
+
+  std::uint64_t read() {
+    if (compressed) {
+      return reader.readVarint();
+    }
+    return reader.read<std::uint32_t>();
+  }
+
+private:
+  PayloadReader reader;
+  bool compressed;
+};
+
+/// Read-only view of a file that is memory-mapped where supported
+class MappedFile {
+public:
+  explicit MappedFile(const std::string& filename) {
+#ifdef MQT_CORE_DD_USE_MMAP
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::invalid_argument("Cannot open serialized file: " + filename);
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Cannot determine size of file: " + filename);
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    if (length != 0U) {
+      auto* addr = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        mapping = addr;
+        ::madvise(addr, length, MADV_SEQUENTIAL);
+        return;
+      }
+    }
+    ::close(fd);
+    fd = -1;
+#endif
+    // fall back to reading the whole file
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.good()) {
+      throw std::invalid_argument("Cannot open serialized file: " + filename);
+    }
+    ifs.seekg(0, std::ios::end);
+    const auto end = ifs.tellg();
+    if (end < 0) {
+      throw std::runtime_error("Cannot determine size of file: " + filename);
+    }
+    length = static_cast<std::size_t>(end);
+    buffer.resize(length);
+    ifs.seekg(0, std::ios::beg);
+    if (!ifs.read(buffer.data(), static_cast<std::streamsize>(length))) {
+      throw std::runtime_error("Cannot read serialized file: " + filename);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+
+  ~MappedFile() {
+#ifdef MQT_CORE_DD_USE_MMAP
+    if (mapping != nullptr) {
+      ::munmap(mapping, length);
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+#endif
+  }
+
+  [[nodiscard]] const char* data() const noexcept {
+    if (mapping != nullptr) {
+      return static_cast<const char*>(mapping);
+    }
+    return buffer.data();
+  }
+  [[nodiscard]] std::size_t size() const noexcept { return length; }
+
+private:
+  void* mapping = nullptr;
+  std::size_t length = 0U;
+  std::vector<char> buffer;
+#ifdef MQT_CORE_DD_USE_MMAP
+  int fd = -1;
+#endif
+};
+} // namespace
+
+template <class Node>
+void serializeCompact(const Edge<Node>& e, std::ostream& os,
+                      const bool compress) {
+  constexpr std::size_t N = std::tuple_size_v<decltype(Node::e)>;
+
+  // collect all nodes grouped by their level
+  std::vector<std::vector<const Node*>> levels{};
+  if (!e.isTerminal()) {
+    levels.resize(static_cast<std::size_t>(e.p->v) + 1U);
+    std::unordered_set<const Node*> visited{e.p};
+    std::vector<const Node*> stack{e.p};
+    while (!stack.empty()) {
+      const auto* p = stack.back();
+      stack.pop_back();
+      levels[p->v].emplace_back(p);
+      for (const auto& s : p->e) {
+        if (!s.isTerminal() && visited.emplace(s.p).second) {
+          stack.emplace_back(s.p);
+        }
+      }
+    }
+  }
+
+  CompactSerializationHeader header{};
+  header.radix = static_cast<std::uint32_t>(N);
+  header.flags = compress ? CompactSerializationHeader::Compressed : 0U;
+  header.numLevels = static_cast<std::uint32_t>(levels.size());
+
+  std::unordered_map<const Node*, std::uint64_t> nodeIndex{};
+  for (const auto& level : levels) {
+    for (const auto* p : level) {
+      nodeIndex.emplace(p, nodeIndex.size() + 1U);
+    }
+  }
+  header.numNodes = nodeIndex.size();
+  if (!compress &&
+      header.numNodes >= std::numeric_limits<std::uint32_t>::max()) {
+    throw std::runtime_error(
+        "DD is too large for the uncompressed compact serialization format.");
+  }
+
+  // deduplicate the weights based on the entries of the real number table
+  using WeightKey = std::pair<const RealNumber*, const RealNumber*>;
+  std::unordered_map<WeightKey, std::uint64_t, qc::PairHash<const RealNumber*,
+                                                            const RealNumber*>>
+      weightIndex{};
+  std::vector<std::pair<fp, fp>> weights{{0., 0.}, {1., 0.}};
+  const auto getWeightIndex = [&weightIndex, &weights](const Complex& w) {
+    if (w.exactlyZero()) {
+      return std::uint64_t{0U};
+    }
+    if (w.exactlyOne()) {
+      return std::uint64_t{1U};
+    }
+    const auto [it, inserted] =
+        weightIndex.emplace(WeightKey{w.r, w.i}, weights.size());
+    if (inserted) {
+      weights.emplace_back(RealNumber::val(w.r), RealNumber::val(w.i));
+    }
+    return it->second;
+  };
+
+  PayloadWriter successors{};
+  PayloadWriter weightColumn{};
+  for (const auto& level : levels) {
+    for (const auto* p : level) {
+      const auto self = nodeIndex[p];
+      for (const auto& s : p->e) {
+        const auto succ = s.isTerminal() ? 0U : nodeIndex[s.p];
+        const auto w = getWeightIndex(s.w);
+        if (compress) {
+          // successors always precede the node, so the offset is positive
+          successors.writeVarint(succ == 0U ? 0U : self - succ);
+          weightColumn.writeVarint(w);
+        } else {
+          successors.write(static_cast<std::uint32_t>(succ));
+          weightColumn.write(static_cast<std::uint32_t>(w));
+        }
+      }
+    }
+  }
+  header.root = e.isTerminal() ? 0U : nodeIndex[e.p];
+  header.rootWeight = getWeightIndex(e.w);
+  header.numWeights = weights.size();
+  if (!compress &&
+      header.numWeights >= std::numeric_limits<std::uint32_t>::max()) {
+    throw std::runtime_error(
+        "DD is too large for the uncompressed compact serialization format.");
+  }
+
+  PayloadWriter payload{};
+  for (const auto& level : levels) {
+    payload.write(static_cast<std::uint64_t>(level.size()));
+  }
+  for (const auto& [re, im] : weights) {
+    payload.write(re);
+    payload.write(im);
+  }
+  payload.write(std::uint64_t{successors.size()});
+  payload.write(std::uint64_t{weightColumn.size()});
+  const auto& payloadData = payload.data();
+  header.payloadSize =
+      payload.size() + successors.size() + weightColumn.size();
+
+  // the checksum covers the concatenation of all payload sections
+  auto checksum = fnv1a(payloadData.data(), payloadData.size());
+  checksum = fnv1a(successors.data().data(), successors.size(), checksum);
+  header.checksum =
+      fnv1a(weightColumn.data().data(), weightColumn.size(), checksum);
+
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(payloadData.data(), static_cast<std::streamsize>(payload.size()));
+  os.write(successors.data().data(),
+           static_cast<std::streamsize>(successors.size()));
+  os.write(weightColumn.data().data(),
+           static_cast<std::streamsize>(weightColumn.size()));
+}
+
+template <class Node>
+void serializeCompact(const Edge<Node>& e, const std::string& outputFilename,
+                      const bool compress) {
+  std::ofstream ofs(outputFilename, std::ios::binary);
+  if (!ofs.good()) {
+    throw std::invalid_argument("Cannot open file: " + outputFilename);
+  }
+  serializeCompact(e, ofs, compress);
+}
+
+template <class Node, class Config>
+Edge<Node> deserializeCompact(const char* data, const std::size_t size,
+                              Package<Config>& dd) {
+  constexpr std::size_t N = std::tuple_size_v<decltype(Node::e)>;
+
+  CompactSerializationHeader header{};
+  if (size < sizeof(header)) {
+    throw std::runtime_error("Compact serialization is truncated.");
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != COMPACT_SERIALIZATION_MAGIC) {
+    throw std::runtime_error("Data is not a compact DD serialization.");
+  }
+  if (header.version != COMPACT_SERIALIZATION_VERSION) {
+    throw std::runtime_error(
+        "Wrong Version of serialization file version. version of file: " +
+        std::to_string(header.version) + "; current version: " +
+        std::to_string(COMPACT_SERIALIZATION_VERSION));
+  }
+  if (header.radix != N) {
+    throw std::runtime_error(
+        "Serialized DD has " + std::to_string(header.radix) +
+        " successors per node, but " + std::to_string(N) + " were expected.");
+  }
+  const auto* payloadData = data + sizeof(header);
+  if (size - sizeof(header) != header.payloadSize) {
+    throw std::runtime_error("Compact serialization is truncated.");
+  }
+  if (fnv1a(payloadData, header.payloadSize) != header.checksum) {
+    throw std::runtime_error("Checksum mismatch in compact serialization.");
+  }
+  if (header.numLevels > dd.qubits()) {
+    throw std::runtime_error(
+        "Serialized DD acts on " + std::to_string(header.numLevels) +
+        " qubits, but the package only supports " +
+        std::to_string(dd.qubits()) + ".");
+  }
+
+  PayloadReader payload{payloadData, header.payloadSize};
+  std::vector<std::uint64_t> levelSizes(header.numLevels);
+  std::uint64_t totalNodes = 0U;
+  for (auto& levelSize : levelSizes) {
+    levelSize = payload.read<std::uint64_t>();
+    totalNodes += levelSize;
+  }
+  if (totalNodes != header.numNodes || header.root > header.numNodes ||
+      header.rootWeight >= header.numWeights || header.numWeights < 2U) {
+    throw std::runtime_error("Compact serialization is inconsistent.");
+  }
+
+  // every distinct weight is only looked up once
+  std::vector<Complex> weights{};
+  weights.reserve(header.numWeights);
+  weights.emplace_back(Complex::zero());
+  weights.emplace_back(Complex::one());
+  for (std::uint64_t i = 0U; i < header.numWeights; ++i) {
+    const auto re = payload.read<fp>();
+    const auto im = payload.read<fp>();
+    if (i >= 2U) {
+      weights.emplace_back(dd.cn.lookup(re, im));
+    }
+  }
+
+  const auto successorSize = payload.read<std::uint64_t>();
+  const auto weightSize = payload.read<std::uint64_t>();
+  const bool compressed =
+      (header.flags & CompactSerializationHeader::Compressed) != 0U;
+  ColumnReader successors{payload.section(successorSize), compressed};
+  ColumnReader weightColumn{payload.section(weightSize), compressed};
+  if (!payload.atEnd()) {
+    throw std::runtime_error("Compact serialization is inconsistent.");
+  }
+
+  // nodes are inserted into the unique table in level order, so all
+  // successors of a node have already been created when it is processed
+  auto& memoryManager = dd.template getMemoryManager<Node>();
+  auto& uniqueTable = dd.template getUniqueTable<Node>();
+  std::vector<Node*> nodes{};
+  nodes.reserve(header.numNodes);
+  std::array<std::uint64_t, N> succ{};
+  std::array<std::uint64_t, N> w{};
+  for (std::size_t v = 0U; v < levelSizes.size(); ++v) {
+    for (std::uint64_t k = 0U; k < levelSizes[v]; ++k) {
+      const auto self = nodes.size() + 1U;
+      for (std::size_t i = 0U; i < N; ++i) {
+        auto s = successors.read();
+        if (compressed && s != 0U) {
+          s = s < self ? self - s : self;
+        }
+        succ[i] = s;
+        w[i] = weightColumn.read();
+        if (succ[i] >= self || w[i] >= header.numWeights ||
+            (succ[i] != 0U && nodes[succ[i] - 1U]->v >= v)) {
+          throw std::runtime_error("Compact serialization is inconsistent.");
+        }
+      }
+
+      auto* p = memoryManager.get();
+      p->v = static_cast<Qubit>(v);
+      if constexpr (std::is_same_v<Node, mNode>) {
+        p->flags = 0;
+      }
+      for (std::size_t i = 0U; i < N; ++i) {
+        if (w[i] == 0U) {
+          p->e[i] = Edge<Node>::zero();
+        } else {
+          p->e[i] = {succ[i] == 0U ? Node::getTerminal() : nodes[succ[i] - 1U],
+                     weights[w[i]]};
+        }
+      }
+      nodes.emplace_back(uniqueTable.lookup(p));
+    }
+  }
+
+  if (header.root == 0U) {
+    return Edge<Node>::terminal(weights[header.rootWeight]);
+  }
+  return {nodes[header.root - 1U], weights[header.rootWeight]};
+}
+
+template <class Node, class Config>
+Edge<Node> deserializeCompact(std::istream& is, Package<Config>& dd) {
+  const std::vector<char> buffer{std::istreambuf_iterator<char>(is),
+                                 std::istreambuf_iterator<char>()};
+  return deserializeCompact<Node>(buffer.data(), buffer.size(), dd);
+}
+
+template <class Node, class Config>
+Edge<Node> deserializeCompact(const std::string& inputFilename,
+                              Package<Config>& dd) {
+  const MappedFile file(inputFilename);
+  return deserializeCompact<Node>(file.data(), file.size(), dd);
+}
+
+template void serializeCompact<vNode>(const vEdge& e, std::ostream& os,
+                                      bool compress);
+template void serializeCompact<mNode>(const mEdge& e, std::ostream& os,
+                                      bool compress);
+template void serializeCompact<vNode>(const vEdge& e,
+                                      const std::string& outputFilename,
+                                      bool compress);
+template void serializeCompact<mNode>(const mEdge& e,
+                                      const std::string& outputFilename,
+                                      bool compress);
+template vEdge deserializeCompact<vNode, DDPackageConfig>(
+    const char* data, std::size_t size, Package<DDPackageConfig>& dd);
+template mEdge deserializeCompact<mNode, DDPackageConfig>(
+    const char* data, std::size_t size, Package<DDPackageConfig>& dd);
+template vEdge
+deserializeCompact<vNode, DDPackageConfig>(std::istream& is,
+                                           Package<DDPackageConfig>& dd);
+template mEdge
+deserializeCompact<mNode, DDPackageConfig>(std::istream& is,
+                                           Package<DDPackageConfig>& dd);
+template vEdge deserializeCompact<vNode, DDPackageConfig>(
+    const std::string& inputFilename, Package<DDPackageConfig>& dd);
+template mEdge deserializeCompact<mNode, DDPackageConfig>(
+    const std::string& inputFilename, Package<DDPackageConfig>& dd);
+} // namespace dd
@@ -10,8 +10,10 @@
 #include "dd/Simulation.hpp"
 
 #include "Definitions.hpp"
+#include "dd/Checkpoint.hpp"
 #include "dd/DDDefinitions.hpp"
 #include "dd/GateMatrixDefinitions.hpp"
+#include "dd/Node.hpp"
 #include "dd/Package.hpp"
 #include "dd/RealNumber.hpp"
 #include "ir/QuantumComputation.hpp"
@@ -21,18 +23,95 @@
 
 #include <array>
 #include <cstddef>
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <random>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace dd {
+namespace {
+/// Set up a checkpointed simulation, either from scratch or from a checkpoint
+template <class Config>
+SimulationCheckpoint
+startCheckpointedSimulation(const QuantumComputation* qc, const VectorDD& in,
+                            Package<Config>& dd,
+                            const CheckpointOptions& checkpointing) {
+  if (checkpointing.resume && std::filesystem::exists(checkpointing.filename)) {
+    auto checkpoint = loadCheckpoint(checkpointing.filename, dd);
+    if (checkpoint.numOperations != qc->getNops() ||
+        checkpoint.nextOperation > qc->getNops() ||
+        checkpoint.fingerprint != circuitFingerprint(*qc)) {
+      dd.decRef(checkpoint.state);
+      throw std::invalid_argument(
+          "Checkpoint " + checkpointing.filename +
+          " does not belong to the circuit to be simulated.");
+    }
+    // the initial state is superseded by the checkpointed one
+    dd.decRef(in);
+    return checkpoint;
+  }
+  SimulationCheckpoint checkpoint{};
+  checkpoint.state = in;
+  checkpoint.permutation = qc->initialLayout;
+  checkpoint.numOperations = qc->getNops();
+  checkpoint.fingerprint = circuitFingerprint(*qc);
+  return checkpoint;
+}
+
+/**
+ * @brief Apply the remaining unitary operations of a checkpointed simulation
+ * @details A checkpoint is written every `checkpointing.interval` operations
+ * (counted from the start of the circuit). If @p rng is given, its state is
+ * stored alongside the simulation state.
+ */
+template <class Config>
+void runCheckpointedSimulation(const QuantumComputation* qc,
+                               SimulationCheckpoint& checkpoint,
+                               Package<Config>& dd,
+                               const CheckpointOptions& checkpointing,
+                               const std::mt19937_64* rng) {
+  const auto nops = qc->getNops();
+  std::vector states{checkpoint.state};
+  const auto afterOperation = [&](const std::size_t i) {
+    checkpoint.state = states.front();
+    checkpoint.nextOperation = i + 1U;
+    if (checkpointing.enabled() && checkpoint.nextOperation < nops &&
+        checkpoint.nextOperation % checkpointing.interval == 0U) {
+      if (rng != nullptr) {
+        std::ostringstream oss;
+        oss << *rng;
+        checkpoint.rngState = oss.str();
+      }
+      saveCheckpoint(checkpointing.filename, checkpoint,
+                     checkpointing.compress);
+    }
+  };
+  simulateOperations(*qc, checkpoint.nextOperation, states,
+                     checkpoint.permutation, dd, afterOperation, true);
+}
+} // namespace
+
+template <class Config>
+VectorDD simulate(const QuantumComputation* qc, const VectorDD& in,
+                  Package<Config>& dd, const CheckpointOptions& checkpointing) {
+  auto checkpoint = startCheckpointedSimulation(qc, in, dd, checkpointing);
+  runCheckpointedSimulation(qc, checkpoint, dd, checkpointing, nullptr);
+  auto e = checkpoint.state;
+  changePermutation(e, checkpoint.permutation, qc->outputPermutation, dd);
+  e = dd.reduceGarbage(e, qc->garbage);
+  return e;
+}
+
 template <class Config>
 std::map<std::string, std::size_t>
 sample(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
-       const std::size_t shots, const std::size_t seed) {
+       const std::size_t shots, const std::size_t seed,
+       const CheckpointOptions& checkpointing) {
   auto isDynamicCircuit = false;
   auto hasMeasurements = false;
   auto measurementsLast = true;
@@ -90,27 +169,16 @@ sample(const QuantumComputation* qc, const VectorDD& in, Package<Config>& dd,
   if (!isDynamicCircuit) {
     // if all gates are unitary (besides measurements at the end), we just
     // simulate once and measure all qubits repeatedly
-    auto permutation = qc->initialLayout;
-    auto e = in;
-
-    for (const auto& op : *qc) {
-      // simply skip any non-unitary
-      if (!op->isUnitary()) {
-        continue;
-      }
-
-      // SWAP gates can be executed virtually by changing the permutation
-      if (op->getType() == OpType::SWAP && !op->isControlled()) {
-        const auto& targets = op->getTargets();
-        std::swap(permutation.at(targets[0U]), permutation.at(targets[1U]));
-        continue;
-      }
-
-      e = applyUnitaryOperation(op.get(), e, dd, permutation);
+    auto checkpoint = startCheckpointedSimulation(qc, in, dd, checkpointing);
+    if (!checkpoint.rngState.empty()) {
+      std::istringstream iss(checkpoint.rngState);
+      iss >> mt;
     }
+    runCheckpointedSimulation(qc, checkpoint, dd, checkpointing, &mt);
+    auto e = checkpoint.state;
 
     // correct permutation if necessary
-    changePermutation(e, permutation, qc->outputPermutation, dd);
+    changePermutation(e, checkpoint.permutation, qc->outputPermutation, dd);
     e = dd.reduceGarbage(e, qc->garbage);
 
     // measure all qubits
@@ -420,10 +488,15 @@ void extractProbabilityVectorRecursive(const QuantumComputation* qc,
   }
 }
 
+template VectorDD
+simulate<DDPackageConfig>(const QuantumComputation* qc, const VectorDD& in,
+                          Package<DDPackageConfig>& dd,
+                          const CheckpointOptions& checkpointing);
 template std::map<std::string, std::size_t>
 sample<DDPackageConfig>(const QuantumComputation* qc, const VectorDD& in,
                         Package<DDPackageConfig>& dd, std::size_t shots,
-                        std::size_t seed);
+                        std::size_t seed,
+                        const CheckpointOptions& checkpointing);
 template void extractProbabilityVector<DDPackageConfig>(
     const QuantumComputation* qc, const VectorDD& in, SparsePVec& probVector,
     Package<DDPackageConfig>& dd);
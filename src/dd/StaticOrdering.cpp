@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/StaticOrdering.hpp"
+
+#include "Definitions.hpp"
+#include "datastructures/UndirectedGraph.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "ir/Permutation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/OpType.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dd {
+
+namespace {
+/// Cuts with more (estimated) entanglement are considered equally bad
+constexpr std::int64_t MAX_EXPONENT = 64;
+/// The number of sifting passes over all qubits
+constexpr std::size_t MAX_SIFTING_PASSES = 4U;
+/// The maximal number of positions a qubit is moved in either direction
+/// during sifting
+constexpr std::size_t MAX_SIFTING_DISTANCE = 16U;
+/// The factor by which the interactions with a placed qubit are discounted
+/// for every qubit placed after it
+constexpr fp GREEDY_DECAY = 0.5;
+
+/**
+ * @brief The multi-qubit interactions of a circuit
+ * @details Qubits are identified by wires, i.e., the indices of the (sorted)
+ * keys of the initial layout. Virtual SWAP gates exchange the wires that the
+ * qubits of subsequent gates refer to.
+ */
+class CircuitStructure {
+public:
+  explicit CircuitStructure(const qc::QuantumComputation& qc) {
+    for (const auto& [qubit, level] : qc.initialLayout) {
+      keys.emplace_back(qubit);
+      levels.emplace_back(level);
+    }
+    std::sort(levels.begin(), levels.end());
+    const auto n = keys.size();
+
+    std::map<qc::Qubit, std::size_t> index{};
+    for (std::size_t w = 0U; w < n; ++w) {
+      index[keys[w]] = w;
+    }
+    std::vector<std::size_t> wire(n);
+    std::iota(wire.begin(), wire.end(), 0U);
+    std::map<std::vector<std::size_t>, std::size_t> groups{};
+    for (const auto& op : qc) {
+      if (!op->isUnitary() || op->getType() == qc::Barrier) {
+        continue;
+      }
+      if (op->getType() == qc::SWAP && !op->isControlled()) {
+        const auto& targets = op->getTargets();
+        std::swap(wire[index.at(targets[0U])], wire[index.at(targets[1U])]);
+        continue;
+      }
+      std::vector<std::size_t> wires{};
+      for (const auto qubit : op->getUsedQubits()) {
+        if (const auto it = index.find(qubit); it != index.end()) {
+          wires.emplace_back(wire[it->second]);
+        }
+      }
+      if (wires.size() >= 2U) {
+        std::sort(wires.begin(), wires.end());
+        ++groups[wires];
+      }
+    }
+
+    std::map<std::pair<std::size_t, std::size_t>, std::size_t> weights{};
+    gatesOf.resize(n);
+    for (const auto& [wires, count] : groups) {
+      for (const auto w : wires) {
+        gatesOf[w].emplace_back(gates.size());
+      }
+      gates.emplace_back(wires, count);
+      for (std::size_t i = 0U; i < wires.size(); ++i) {
+        for (std::size_t j = i + 1U; j < wires.size(); ++j) {
+          weights[{wires[i], wires[j]}] += count;
+        }
+      }
+    }
+    for (std::size_t w = 0U; w < n; ++w) {
+      graph.addVertex(w);
+    }
+    partners.resize(n);
+    for (const auto& [pair, weight] : weights) {
+      graph.addEdge(pair.first, pair.second, weight);
+      partners[pair.first].emplace_back(pair.second);
+      partners[pair.second].emplace_back(pair.first);
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return keys.size(); }
+
+  /// The positions of the wires according to a mapping from qubits to levels
+  [[nodiscard]] std::vector<std::size_t>
+  positions(const qc::Permutation& order) const {
+    std::vector<std::size_t> pos(size());
+    for (std::size_t w = 0U; w < size(); ++w) {
+      const auto it = order.find(keys[w]);
+      const auto level =
+          it == order.end()
+              ? levels.end()
+              : std::lower_bound(levels.begin(), levels.end(), it->second);
+      if (level == levels.end() || *level != it->second) {
+        throw std::invalid_argument(
+            "The qubit order does not map qubit " + std::to_string(keys[w]) +
+            " to a level of the initial layout.");
+      }
+      pos[w] = static_cast<std::size_t>(std::distance(levels.begin(), level));
+    }
+    return pos;
+  }
+
+  /// The mapping from qubits to levels for the given arrangement of wires
+  [[nodiscard]] qc::Permutation
+  permutation(const std::vector<std::size_t>& arrangement) const {
+    qc::Permutation order{};
+    for (std::size_t p = 0U; p < arrangement.size(); ++p) {
+      order[keys[arrangement[p]]] = levels[p];
+    }
+    return order;
+  }
+
+  /// See estimateDDSize()
+  [[nodiscard]] fp cost(const std::vector<std::size_t>& pos) const {
+    const auto n = size();
+    std::vector<std::int64_t> crossing(n + 1U, 0);
+    std::vector<std::int64_t> left(n + 1U, 0);
+    std::vector<std::int64_t> right(n + 1U, 0);
+    for (const auto& [wires, count] : gates) {
+      const auto [lo, hi] =
+          std::minmax_element(wires.begin(), wires.end(),
+                              [&pos](const auto lhs, const auto rhs) {
+                                return pos[lhs] < pos[rhs];
+                              });
+      crossing[pos[*lo]] += static_cast<std::int64_t>(count);
+      crossing[pos[*hi]] -= static_cast<std::int64_t>(count);
+    }
+    for (std::size_t w = 0U; w < n; ++w) {
+      auto lo = pos[w];
+      auto hi = pos[w];
+      for (const auto u : partners[w]) {
+        lo = std::min(lo, pos[u]);
+        hi = std::max(hi, pos[u]);
+      }
+      ++left[pos[w]];
+      --left[hi];
+      ++right[lo];
+      --right[pos[w]];
+    }
+
+    // one node per level plus the nodes below each cut
+    auto total = static_cast<fp>(n);
+    std::int64_t gatesAcross = 0;
+    std::int64_t qubitsBelow = 0;
+    std::int64_t qubitsAbove = 0;
+    for (std::size_t c = 0U; c + 1U < n; ++c) {
+      gatesAcross += crossing[c];
+      qubitsBelow += left[c];
+      qubitsAbove += right[c];
+      const auto entanglement = std::min(
+          {gatesAcross, qubitsBelow, qubitsAbove, MAX_EXPONENT});
+      total += std::ldexp(1., static_cast<int>(entanglement));
+    }
+    return total;
+  }
+
+  /**
+   * @brief Arrange the wires greedily along the interaction graph
+   * @details Starting from a least connected qubit, the next qubit is the one
+   * with the strongest interaction with the already placed qubits, where the
+   * interactions with a placed qubit are discounted by GREEDY_DECAY for every
+   * qubit placed after it. Hence, the scores are updated incrementally.
+   * Qubits without any interaction are placed last.
+   */
+  [[nodiscard]] std::vector<std::size_t> greedyArrangement() const {
+    const auto n = size();
+    std::vector<std::size_t> arrangement{};
+    std::vector<bool> placed(n, false);
+    std::vector<fp> score(n, 0.);
+    while (arrangement.size() < n) {
+      std::size_t next = n;
+      fp bestScore = 0.;
+      for (std::size_t v = 0U; v < n; ++v) {
+        if (!placed[v] && score[v] > bestScore) {
+          bestScore = score[v];
+          next = v;
+        }
+      }
+      if (next == n) {
+        // start a new component with a least connected qubit
+        for (std::size_t v = 0U; v < n; ++v) {
+          if (placed[v]) {
+            continue;
+          }
+          if (next == n) {
+            next = v;
+            continue;
+          }
+          const auto degree = graph.getDegree(v);
+          const auto nextDegree = graph.getDegree(next);
+          if (degree != 0U && (nextDegree == 0U || degree < nextDegree)) {
+            next = v;
+          }
+        }
+      }
+      placed[next] = true;
+      arrangement.emplace_back(next);
+      for (auto& s : score) {
+        s *= GREEDY_DECAY;
+      }
+      for (const auto u : partners[next]) {
+        score[u] += static_cast<fp>(graph.getEdge(next, u));
+      }
+    }
+    return arrangement;
+  }
+
+  /**
+   * @brief Move each wire to its best position (at most MAX_SIFTING_DISTANCE
+   * positions away) until no move improves the cost
+   * @details Wires are moved by exchanging adjacent positions, which only
+   * changes the terms of the cut between them (see Sifting::exchange()).
+   */
+  void sift(std::vector<std::size_t>& arrangement) const {
+    const auto n = size();
+    std::vector<std::size_t> wires(n);
+    std::iota(wires.begin(), wires.end(), 0U);
+    std::stable_sort(wires.begin(), wires.end(),
+                     [this](const std::size_t lhs, const std::size_t rhs) {
+                       return graph.getDegree(lhs) > graph.getDegree(rhs);
+                     });
+
+    Sifting sifting(*this, arrangement);
+    for (std::size_t pass = 0U; pass < MAX_SIFTING_PASSES; ++pass) {
+      auto improved = false;
+      for (const auto w : wires) {
+        const auto start = sifting.position(w);
+        const auto first =
+            start > MAX_SIFTING_DISTANCE ? start - MAX_SIFTING_DISTANCE : 0U;
+        const auto last = std::min(n - 1U, start + MAX_SIFTING_DISTANCE);
+        // the cost relative to the cost with the wire at its start position
+        fp delta = 0.;
+        fp bestDelta = 0.;
+        auto best = start;
+        for (auto p = start; p > first; --p) {
+          delta += sifting.exchange(p - 1U);
+          if (delta < bestDelta) {
+            bestDelta = delta;
+            best = p - 1U;
+          }
+        }
+        for (auto p = first; p < last; ++p) {
+          delta += sifting.exchange(p);
+          if (delta < bestDelta) {
+            bestDelta = delta;
+            best = p + 1U;
+          }
+        }
+        for (auto p = last; p > best; --p) {
+          sifting.exchange(p - 1U);
+        }
+        improved |= best != start;
+      }
+      if (!improved) {
+        break;
+      }
+    }
+    arrangement = sifting.getArrangement();
+  }
+
+private:
+  /**
+   * @brief An arrangement of the wires together with the terms of the cost
+   * of each cut
+   * @details For each wire, the positions of its outermost partners are kept
+   * as well, such that exchanging two adjacent wires only takes time
+   * proportional to their interactions.
+   */
+  class Sifting {
+  public:
+    Sifting(const CircuitStructure& circuit,
+            const std::vector<std::size_t>& initial)
+        : structure(&circuit), arrangement(initial), pos(initial.size()),
+          lo(initial.size()), hi(initial.size()), mark(initial.size(), 0U),
+          gatesAcross(initial.size(), 0), qubitsBelow(initial.size(), 0),
+          qubitsAbove(initial.size(), 0) {
+      const auto n = arrangement.size();
+      for (std::size_t p = 0U; p < n; ++p) {
+        pos[arrangement[p]] = p;
+      }
+      for (std::size_t w = 0U; w < n; ++w) {
+        updateRange(w);
+        for (auto c = pos[w]; c < hi[w]; ++c) {
+          ++qubitsBelow[c];
+        }
+        for (auto c = lo[w]; c < pos[w]; ++c) {
+          ++qubitsAbove[c];
+        }
+      }
+      for (const auto& [wires, count] : structure->gates) {
+        const auto [first, last] = span(wires);
+        for (auto c = first; c < last; ++c) {
+          gatesAcross[c] += static_cast<std::int64_t>(count);
+        }
+      }
+    }
+
+    [[nodiscard]] std::size_t position(const std::size_t w) const {
+      return pos[w];
+    }
+
+    [[nodiscard]] const std::vector<std::size_t>& getArrangement() const {
+      return arrangement;
+    }
+
+    /**
+     * @brief Exchange the wires at positions @p p and p + 1
+     * @details Since no wire changes its side of any other cut, only the
+     * terms of cut @p p change. They are updated from the gates and partners
+     * of the two wires.
+     * @return The change of the cost
+     */
+    fp exchange(const std::size_t p) {
+      const auto w = arrangement[p];
+      const auto u = arrangement[p + 1U];
+      const auto before = term(p);
+
+      changedGates = structure->gatesOf[w];
+      for (const auto g : structure->gatesOf[u]) {
+        const auto& wires = structure->gates[g].first;
+        if (!std::binary_search(wires.begin(), wires.end(), w)) {
+          changedGates.emplace_back(g);
+        }
+      }
+      // wires that are partners of only one of the two change their range
+      changedWires.assign({w, u});
+      for (const auto x : structure->partners[w]) {
+        if (x != u) {
+          mark[x] |= 1U;
+          changedWires.emplace_back(x);
+        }
+      }
+      for (const auto x : structure->partners[u]) {
+        if (x != w) {
+          if (mark[x] == 0U) {
+            changedWires.emplace_back(x);
+          }
+          mark[x] |= 2U;
+        }
+      }
+
+      updateCut(p, -1);
+      std::swap(arrangement[p], arrangement[p + 1U]);
+      pos[w] = p + 1U;
+      pos[u] = p;
+      for (const auto x : changedWires) {
+        if (mark[x] == 1U) {
+          lo[x] = lo[x] == p ? p + 1U : lo[x];
+          hi[x] = hi[x] == p ? p + 1U : hi[x];
+        } else if (mark[x] == 2U) {
+          lo[x] = lo[x] == p + 1U ? p : lo[x];
+          hi[x] = hi[x] == p + 1U ? p : hi[x];
+        }
+      }
+      updateRange(w);
+      updateRange(u);
+      updateCut(p, 1);
+      for (const auto x : changedWires) {
+        mark[x] = 0U;
+      }
+      return term(p) - before;
+    }
+
+  private:
+    const CircuitStructure* structure;
+    std::vector<std::size_t> arrangement;
+    std::vector<std::size_t> pos;
+    /// The lowest position of each wire and its partners
+    std::vector<std::size_t> lo;
+    /// The highest position of each wire and its partners
+    std::vector<std::size_t> hi;
+    /// Whether a wire is a partner of the first (1) or second (2) exchanged
+    /// wire (or both)
+    std::vector<std::uint8_t> mark;
+    /// The number of gates across each cut
+    std::vector<std::int64_t> gatesAcross;
+    /// The number of qubits below each cut that interact across it
+    std::vector<std::int64_t> qubitsBelow;
+    /// The number of qubits above each cut that interact across it
+    std::vector<std::int64_t> qubitsAbove;
+    /// The gates and wires whose contributions change during an exchange
+    std::vector<std::size_t> changedGates;
+    std::vector<std::size_t> changedWires;
+
+    /// The lowest and highest position of a gate
+    [[nodiscard]] std::pair<std::size_t, std::size_t>
+    span(const std::vector<std::size_t>& wires) const {
+      auto first = pos[wires.front()];
+      auto last = first;
+      for (const auto w : wires) {
+        first = std::min(first, pos[w]);
+        last = std::max(last, pos[w]);
+      }
+      return {first, last};
+    }
+
+    void updateRange(const std::size_t w) {
+      lo[w] = pos[w];
+      hi[w] = pos[w];
+      for (const auto u : structure->partners[w]) {
+        lo[w] = std::min(lo[w], pos[u]);
+        hi[w] = std::max(hi[w], pos[u]);
+      }
+    }
+
+    /// Add (@p sign = 1) or remove (@p sign = -1) the contributions of the
+    /// changed gates and wires to cut @p c
+    void updateCut(const std::size_t c, const std::int64_t sign) {
+      for (const auto g : changedGates) {
+        const auto& [gateWires, count] = structure->gates[g];
+        const auto [first, last] = span(gateWires);
+        if (first <= c && c < last) {
+          gatesAcross[c] += sign * static_cast<std::int64_t>(count);
+        }
+      }
+      for (const auto x : changedWires) {
+        if (pos[x] <= c && c < hi[x]) {
+          qubitsBelow[c] += sign;
+        }
+        if (lo[x] <= c && c < pos[x]) {
+          qubitsAbove[c] += sign;
+        }
+      }
+    }
+
+    [[nodiscard]] fp term(const std::size_t c) const {
+      const auto entanglement = std::min(
+          {gatesAcross[c], qubitsBelow[c], qubitsAbove[c], MAX_EXPONENT});
+      return std::ldexp(1., static_cast<int>(entanglement));
+    }
+  };
+
+  /// The keys of the initial layout (indexed by wire)
+  std::vector<qc::Qubit> keys;
+  /// The (sorted) values of the initial layout
+  std::vector<qc::Qubit> levels;
+  /// The wires acted on by multi-qubit gates and the number of such gates
+  std::vector<std::pair<std::vector<std::size_t>, std::size_t>> gates;
+  /// The number of gates acting on each pair of wires
+  qc::UndirectedGraph<std::size_t, std::size_t> graph;
+  /// The wires each wire interacts with
+  std::vector<std::vector<std::size_t>> partners;
+  /// The indices of the gates acting on each wire
+  std::vector<std::vector<std::size_t>> gatesOf;
+};
+} // namespace
+
+fp estimateDDSize(const qc::QuantumComputation& qc,
+                  const qc::Permutation& order) {
+  const CircuitStructure structure(qc);
+  return structure.cost(structure.positions(order));
+}
+
+qc::Permutation proposeQubitOrder(const qc::QuantumComputation& qc) {
+  const CircuitStructure structure(qc);
+  if (structure.size() < 2U) {
+    return qc.initialLayout;
+  }
+  auto arrangement = structure.greedyArrangement();
+  structure.sift(arrangement);
+  auto order = structure.permutation(arrangement);
+  if (structure.cost(structure.positions(order)) <
+      structure.cost(structure.positions(qc.initialLayout))) {
+    return order;
+  }
+  return qc.initialLayout;
+}
+
+} // namespace dd
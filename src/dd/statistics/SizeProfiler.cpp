@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/statistics/SizeProfiler.hpp"
+
+#include "dd/statistics/Tracer.hpp"
+#include "dd/statistics/UniqueTableStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dd {
+
+void SizeProfiler::record(const std::string& name,
+                          const std::vector<UniqueTableStatistics>& stats) {
+  auto& sample = samples.emplace_back();
+  sample.name = name;
+  sample.nodesPerLevel.reserve(stats.size());
+  for (const auto& stat : stats) {
+    sample.nodesPerLevel.emplace_back(stat.numActiveEntries.get());
+    sample.nodes += sample.nodesPerLevel.back();
+  }
+}
+
+SizeReport SizeProfiler::report(const double threshold) const {
+  SizeReport result{};
+  if (samples.empty()) {
+    return result;
+  }
+
+  const auto peak =
+      std::max_element(samples.begin(), samples.end(),
+                       [](const SizeSample& lhs, const SizeSample& rhs) {
+                         return lhs.nodes < rhs.nodes;
+                       });
+  result.peakNodes = peak->nodes;
+  result.peakOperation =
+      static_cast<std::size_t>(std::distance(samples.begin(), peak));
+  const auto& levels = peak->nodesPerLevel;
+  result.peakLevel = static_cast<std::size_t>(std::distance(
+      levels.begin(), std::max_element(levels.begin(), levels.end())));
+
+  const auto limit = std::max<std::size_t>(
+      1U, static_cast<std::size_t>(
+              std::ceil(threshold * static_cast<double>(result.peakNodes))));
+  // the most recent operation with minimal size since the last range
+  std::size_t minOperation = 0U;
+  bool hasMin = false;
+  bool inRange = false;
+  for (std::size_t i = 0U; i < samples.size(); ++i) {
+    const auto nodes = samples[i].nodes;
+    if (nodes < limit) {
+      inRange = false;
+      if (!hasMin || nodes <= samples[minOperation].nodes) {
+        minOperation = i;
+        hasMin = true;
+      }
+      continue;
+    }
+    if (!inRange) {
+      inRange = true;
+      auto& range = result.ranges.emplace_back();
+      range.first = i;
+      range.growthStart = hasMin ? minOperation : i;
+      hasMin = false;
+    }
+    auto& range = result.ranges.back();
+    range.last = i;
+    if (nodes > range.maxNodes) {
+      range.maxNodes = nodes;
+      range.maxOperation = i;
+    }
+  }
+  return result;
+}
+
+void SizeReport::print(std::ostream& os,
+                       const std::vector<SizeSample>& samples) const {
+  const auto name = [&samples](const std::size_t i) {
+    return i < samples.size() ? samples[i].name : std::string{};
+  };
+  os << "Peak of " << peakNodes << " nodes after operation " << peakOperation
+     << " (" << name(peakOperation) << "), most nodes on level " << peakLevel
+     << "\n";
+  for (const auto& range : ranges) {
+    os << "  operations " << range.first << " (" << name(range.first)
+       << ") to " << range.last << " (" << name(range.last) << "): up to "
+       << range.maxNodes << " nodes after operation " << range.maxOperation
+       << ", grown from operation " << range.growthStart << "\n";
+  }
+}
+
+void SizeProfiler::exportCSV(std::ostream& os) const {
+  std::size_t levels = 0U;
+  for (const auto& sample : samples) {
+    levels = std::max(levels, sample.nodesPerLevel.size());
+  }
+  os << "operation,name,nodes";
+  for (std::size_t v = 0U; v < levels; ++v) {
+    os << ",level_" << v;
+  }
+  os << "\n";
+  for (std::size_t i = 0U; i < samples.size(); ++i) {
+    const auto& sample = samples[i];
+    os << i << "," << csvField(sample.name) << "," << sample.nodes;
+    for (std::size_t v = 0U; v < levels; ++v) {
+      os << ","
+         << (v < sample.nodesPerLevel.size() ? sample.nodesPerLevel[v] : 0U);
+    }
+    os << "\n";
+  }
+}
+
+void SizeProfiler::exportCSV(const std::string& filename) const {
+  std::ofstream ofs(filename);
+  if (!ofs.good()) {
+    throw std::invalid_argument("Cannot open file: " + filename);
+  }
+  exportCSV(ofs);
+}
+
+} // namespace dd
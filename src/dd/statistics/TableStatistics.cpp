@@ -10,6 +10,7 @@
 #include "dd/statistics/TableStatistics.hpp"
 
 #include "dd/statistics/Statistics.hpp"
+#include "dd/statistics/StatisticsCounter.hpp"
 
 #include <algorithm>
 #include <nlohmann/json.hpp>
@@ -19,11 +20,20 @@ namespace dd {
 void TableStatistics::trackInsert() noexcept {
   ++inserts;
   ++numEntries;
-  peakNumEntries = std::max(peakNumEntries, numEntries);
+  peakNumEntries = std::max(peakNumEntries.get(), numEntries.get());
 }
 
 void TableStatistics::reset() noexcept { numEntries = 0U; }
 
+bool TableStatistics::unused() const noexcept {
+  if constexpr (STATISTICS_ENABLED) {
+    return lookups == 0U;
+  } else {
+    // without profiling counters, only the number of entries is available
+    return peakNumEntries == 0U;
+  }
+}
+
 double TableStatistics::hitRatio() const noexcept {
   if (lookups == 0) {
     return 1.;
@@ -54,19 +64,19 @@ double TableStatistics::getMemoryMiB() const noexcept {
 }
 
 nlohmann::basic_json<> TableStatistics::json() const {
-  if (lookups == 0) {
+  if (unused()) {
     return "unused";
   }
 
   auto j = Statistics::json();
   j["num_buckets"] = numBuckets;
   j["memory_MiB"] = getMemoryMiB();
-  j["num_entries"] = numEntries;
-  j["peak_num_entries"] = peakNumEntries;
-  j["collisions"] = collisions;
-  j["hits"] = hits;
-  j["lookups"] = lookups;
-  j["inserts"] = inserts;
+  j["num_entries"] = numEntries.get();
+  j["peak_num_entries"] = peakNumEntries.get();
+  j["collisions"] = collisions.get();
+  j["hits"] = hits.get();
+  j["lookups"] = lookups.get();
+  j["inserts"] = inserts.get();
   j["hit_ratio"] = hitRatio();
   j["col_ratio"] = colRatio();
   j["load_factor"] = loadFactor();
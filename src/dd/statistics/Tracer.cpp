@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/statistics/Tracer.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace dd {
+
+namespace {
+const char* toString(const TraceEvent::Type type) {
+  return type == TraceEvent::Type::Operation ? "operation"
+                                             : "garbage_collection";
+}
+
+std::ofstream openOutputFile(const std::string& filename) {
+  std::ofstream ofs(filename);
+  if (!ofs.good()) {
+    throw std::invalid_argument("Cannot open file: " + filename);
+  }
+  return ofs;
+}
+} // namespace
+
+std::string csvField(const std::string& field) {
+  if (field.find_first_of(",\"\n") == std::string::npos) {
+    return field;
+  }
+  std::string quoted = "\"";
+  for (const auto c : field) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  quoted += '"';
+  return quoted;
+}
+
+double TraceEvent::hitRatio() const noexcept {
+  if (computeTableLookups == 0U) {
+    return 1.;
+  }
+  return static_cast<double>(computeTableHits) /
+         static_cast<double>(computeTableLookups);
+}
+
+double Tracer::now() const {
+  return std::chrono::duration<double, std::micro>(Clock::now() - origin)
+      .count();
+}
+
+void Tracer::clear() {
+  events.clear();
+  origin = Clock::now();
+}
+
+void Tracer::exportChromeTrace(std::ostream& os) const {
+  auto traceEvents = nlohmann::json::array();
+  for (const auto& event : events) {
+    nlohmann::json e{};
+    e["name"] = event.name;
+    e["cat"] = toString(event.type);
+    e["ph"] = "X";
+    e["ts"] = event.start;
+    e["dur"] = event.duration;
+    e["pid"] = 0;
+    e["tid"] = 0;
+    auto& args = e["args"];
+    args["unique_table_growth"] = event.uniqueTableGrowth;
+    args["compute_table_lookups"] = event.computeTableLookups;
+    args["compute_table_hit_ratio"] = event.hitRatio();
+    if (event.type == TraceEvent::Type::Operation) {
+      args["dd_size"] = event.ddSize;
+    } else {
+      args["collected"] = event.collected;
+    }
+    traceEvents.emplace_back(std::move(e));
+
+    // DD sizes are additionally exported as counter track
+    if (event.type == TraceEvent::Type::Operation) {
+      nlohmann::json counter{};
+      counter["name"] = "dd_size";
+      counter["ph"] = "C";
+      counter["ts"] = event.start + event.duration;
+      counter["pid"] = 0;
+      counter["args"]["nodes"] = event.ddSize;
+      traceEvents.emplace_back(std::move(counter));
+    }
+  }
+  nlohmann::json j{};
+  j["traceEvents"] = std::move(traceEvents);
+  j["displayTimeUnit"] = "ms";
+  os << j.dump();
+}
+
+void Tracer::exportChromeTrace(const std::string& filename) const {
+  auto ofs = openOutputFile(filename);
+  exportChromeTrace(ofs);
+}
+
+void Tracer::exportCSV(std::ostream& os) const {
+  const auto precision = os.precision();
+  os.precision(std::numeric_limits<double>::max_digits10);
+  os << "index,type,name,start_us,duration_us,dd_size,unique_table_growth,"
+        "compute_table_lookups,compute_table_hits,collected\n";
+  for (std::size_t i = 0U; i < events.size(); ++i) {
+    const auto& event = events[i];
+    os << i << ',' << toString(event.type) << ',' << csvField(event.name)
+       << ',' << event.start << ',' << event.duration << ',' << event.ddSize
+       << ',' << event.uniqueTableGrowth << ',' << event.computeTableLookups
+       << ',' << event.computeTableHits << ',' << event.collected << '\n';
+  }
+  os.precision(precision);
+}
+
+void Tracer::exportCSV(const std::string& filename) const {
+  auto ofs = openOutputFile(filename);
+  exportCSV(ofs);
+}
+
+} // namespace dd
@@ -18,7 +18,8 @@ namespace dd {
 
 void UniqueTableStatistics::trackActiveEntry() noexcept {
   ++numActiveEntries;
-  peakNumActiveEntries = std::max(peakNumActiveEntries, numActiveEntries);
+  peakNumActiveEntries =
+      std::max(peakNumActiveEntries.get(), numActiveEntries.get());
 }
 
 void UniqueTableStatistics::reset() noexcept {
@@ -27,14 +28,14 @@ void UniqueTableStatistics::reset() noexcept {
 }
 
 nlohmann::basic_json<> UniqueTableStatistics::json() const {
-  if (lookups == 0) {
+  if (unused()) {
     return "unused";
   }
 
   auto j = TableStatistics::json();
-  j["num_active_entries"] = numActiveEntries;
-  j["peak_num_active_entries"] = peakNumActiveEntries;
-  j["gc_runs"] = gcRuns;
+  j["num_active_entries"] = numActiveEntries.get();
+  j["peak_num_active_entries"] = peakNumActiveEntries.get();
+  j["gc_runs"] = gcRuns.get();
   return j;
 }
 } // namespace dd
@@ -127,10 +127,13 @@ def __aggregate(baseline_filepath: str | PathLike[str], feature_filepath: str |
     base_path = Path(baseline_filepath)
     with base_path.open(mode="r", encoding="utf-8") as f:
         d = json.load(f)
+    # the metadata describes the benchmark run and is not compared
+    d.pop("metadata", None)
     flattened_data = __flatten_dict(d)
     feature_path = Path(feature_filepath)
     with feature_path.open(mode="r", encoding="utf-8") as f:
         d_feature = json.load(f)
+    d_feature.pop("metadata", None)
     flattened_feature = __flatten_dict(d_feature)
 
     for k, v in flattened_data.items():
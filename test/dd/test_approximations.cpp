@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/Approximation.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/Package.hpp"
+#include "dd/RealNumber.hpp"
+#include "dd/Simulation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "test_utils.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+
+TEST(DDApproximation, RemovesLowContributionNodes) {
+  constexpr std::size_t nqubits = 6U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  std::mt19937_64 mt(42U);
+
+  const auto exact =
+      dd->makeStateFromVector(dd::randomStateVector(nqubits, mt));
+  dd->incRef(exact);
+  ASSERT_EQ(exact.size(), 1ULL << nqubits);
+
+  auto approximated = exact;
+  dd->incRef(approximated);
+  dd::ApproximationMetadata metadata{};
+  constexpr std::size_t budget = 20U;
+  const auto fidelity = dd::approximate(approximated, budget, *dd, metadata);
+
+  EXPECT_LE(approximated.size(), budget);
+  EXPECT_GT(fidelity, 0.);
+  EXPECT_LT(fidelity, 1.);
+  EXPECT_NEAR(fidelity, dd->fidelity(exact, approximated), dd::RealNumber::eps);
+  EXPECT_NEAR(dd->innerProduct(approximated, approximated).r, 1.,
+              dd::RealNumber::eps);
+  EXPECT_EQ(metadata.rounds, 1U);
+  EXPECT_DOUBLE_EQ(metadata.fidelity, fidelity);
+  EXPECT_GE(metadata.removedNodes, (1ULL << nqubits) - budget);
+
+  dd->decRef(approximated);
+  dd->decRef(exact);
+}
+
+TEST(DDApproximation, KeepsSmallStates) {
+  constexpr std::size_t nqubits = 3U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  auto state = dd->makeGHZState(nqubits);
+  dd->incRef(state);
+  const auto original = state;
+
+  dd::ApproximationMetadata metadata{};
+  EXPECT_EQ(dd::approximate(state, state.size(), *dd, metadata), 1.);
+  EXPECT_EQ(state, original);
+  EXPECT_EQ(metadata.rounds, 0U);
+  dd->decRef(state);
+}
+
+TEST(DDApproximation, BreaksTiesDeterministically) {
+  // both halves of the state have the same norm and consist of nodes with
+  // pairwise equal contributions
+  const dd::CVec vec{{1., 0.}, {2., 0.}, {3., 0.}, {4., 0.},
+                     {4., 0.}, {3., 0.}, {2., 0.}, {1., 0.}};
+  const dd::CVec swapped{vec.rbegin(), vec.rend()};
+  const auto approximateIn = [&vec](dd::Package<>& dd) {
+    auto state = dd.makeStateFromVector(vec);
+    dd.incRef(state);
+    dd::ApproximationMetadata metadata{};
+    dd::approximate(state, state.size() - 1U, dd, metadata);
+    EXPECT_EQ(metadata.removedNodes, 1U);
+    const auto result = state.getVector();
+    dd.decRef(state);
+    return result;
+  };
+
+  auto dd1 = std::make_unique<dd::Package<>>(3U);
+  const auto expected = approximateIn(*dd1);
+  // the node of the second half that is visited first is removed
+  EXPECT_EQ(expected[6], std::complex<dd::fp>{});
+  EXPECT_EQ(expected[7], std::complex<dd::fp>{});
+  EXPECT_NE(expected[0], std::complex<dd::fp>{});
+  // the nodes are allocated in a different order in the second package
+  auto dd2 = std::make_unique<dd::Package<>>(3U);
+  const auto other = dd2->makeStateFromVector(swapped);
+  dd2->incRef(other);
+  const auto actual = approximateIn(*dd2);
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0U; i < expected.size(); ++i) {
+    EXPECT_EQ(actual[i], expected[i]);
+  }
+  dd2->decRef(other);
+}
+
+TEST(DDApproximation, SimulationWithNodeBudget) {
+  constexpr std::size_t nqubits = 6U;
+  qc::QuantumComputation qc(nqubits);
+  std::mt19937_64 mt(1337U);
+  std::uniform_real_distribution<dd::fp> dist(0., 2. * dd::PI);
+  for (std::size_t layer = 0U; layer < 4U; ++layer) {
+    for (qc::Qubit q = 0U; q < nqubits; ++q) {
+      qc.ry(dist(mt), q);
+      qc.rz(dist(mt), q);
+    }
+    for (qc::Qubit q = 0U; q + 1U < nqubits; ++q) {
+      qc.cx(q, q + 1U);
+    }
+  }
+
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  const auto exact = simulate(&qc, in, *dd);
+
+  // a disabled strategy yields the exact result
+  dd::ApproximationMetadata metadata{};
+  dd->incRef(in);
+  const auto unbounded = simulate(&qc, in, *dd, {}, metadata);
+  EXPECT_EQ(unbounded, exact);
+  EXPECT_EQ(metadata.rounds, 0U);
+  EXPECT_EQ(metadata.fidelity, 1.);
+  dd->decRef(unbounded);
+
+  constexpr auto maxNodes = 24U;
+  dd->incRef(in);
+  const auto approximated =
+      simulate(&qc, in, *dd, dd::NodeBudgetApproximation{maxNodes, 0.75},
+               metadata);
+  EXPECT_LE(approximated.size(), maxNodes);
+  EXPECT_GT(metadata.rounds, 0U);
+  EXPECT_GT(metadata.removedNodes, 0U);
+  EXPECT_GT(metadata.fidelity, 0.);
+  EXPECT_LT(metadata.fidelity, 1.);
+  EXPECT_NEAR(dd->innerProduct(approximated, approximated).r, 1.,
+              dd::RealNumber::eps);
+  EXPECT_GT(dd->fidelity(exact, approximated), 0.);
+  dd->decRef(approximated);
+  dd->decRef(exact);
+}
@@ -9,12 +9,14 @@
 
 #include "dd/ComplexNumbers.hpp"
 #include "dd/DDDefinitions.hpp"
+#include "dd/ExactRealNumber.hpp"
 #include "dd/Export.hpp"
 #include "dd/MemoryManager.hpp"
 #include "dd/RealNumber.hpp"
 #include "dd/RealNumberUniqueTable.hpp"
 
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -138,6 +140,117 @@ TEST_F(CNTest, GarbageCollectSomeInBucket) {
   EXPECT_EQ(q->next, nullptr);
 }
 
+TEST_F(CNTest, MemoryIncludesInlineBlocks) {
+  // every bucket holds a pointer to its list and a cache-line sized block
+  const auto& stats = ut.getStats();
+  EXPECT_GE(stats.entrySize, sizeof(RealNumber*) + 64U);
+  EXPECT_GT(stats.getMemoryMiB(), 4.);
+}
+
+TEST_F(CNTest, LookupInOverflowingBucket) {
+  // more values than are stored inline in a bucket, inserted out of order
+  const fp num = 0.5 + 0.25 / 65536.;
+  std::array<dd::fp, 7> numbers{};
+  std::array<RealNumber*, 7> entries{};
+  for (std::size_t i = 0U; i < numbers.size(); ++i) {
+    const auto offset = static_cast<fp>((i * 3U) % numbers.size());
+    numbers[i] = num + 1.5 * offset * RealNumber::eps;
+    entries[i] = ut.lookup(numbers[i]);
+    ASSERT_EQ(RealNumberUniqueTable::hash(numbers[i]),
+              RealNumberUniqueTable::hash(num));
+  }
+
+  // every value (and slight deviations of it) is found again, independent of
+  // whether it is stored inline or in the overflow chain
+  for (std::size_t i = 0U; i < numbers.size(); ++i) {
+    EXPECT_EQ(ut.lookup(numbers[i]), entries[i]);
+    EXPECT_EQ(ut.lookup(numbers[i] + 0.4 * RealNumber::eps), entries[i]);
+    EXPECT_EQ(ut.lookup(numbers[i] - 0.4 * RealNumber::eps), entries[i]);
+  }
+  EXPECT_EQ(ut.getStats().numEntries, numbers.size() + 1U);
+
+  // a value within tolerance of two entries is mapped to the closer one, also
+  // across the border between inline entries and the overflow chain
+  for (const auto offset : {0.9, 5.4, 8.4}) {
+    const auto* closest = ut.lookup(num + offset * RealNumber::eps);
+    EXPECT_DOUBLE_EQ(closest->value, num + (offset + 0.6) * RealNumber::eps);
+  }
+  EXPECT_EQ(ut.getStats().numEntries, numbers.size() + 1U);
+
+  // keep every other value and collect the rest
+  for (std::size_t i = 0U; i < numbers.size(); i += 2U) {
+    ut.incRef(entries[i]);
+  }
+  ut.garbageCollect(true);
+  for (std::size_t i = 0U; i < numbers.size(); ++i) {
+    const auto* entry = ut.lookup(numbers[i]);
+    EXPECT_DOUBLE_EQ(entry->value, numbers[i]);
+    if (i % 2U == 0U) {
+      EXPECT_EQ(entry, entries[i]);
+    }
+  }
+}
+
+TEST(DDExactRealNumberTest, Recognition) {
+  const auto sqrt2over2 = RationalSqrt2::recognize(SQRT2_2);
+  ASSERT_TRUE(sqrt2over2.has_value());
+  EXPECT_EQ(*sqrt2over2, (RationalSqrt2{0, 1, 2}));
+
+  // cos(pi/8)^2 = (2 + sqrt(2)) / 4, slightly perturbed
+  const auto cos2 =
+      RationalSqrt2::recognize(((2. + (2. * SQRT2_2)) / 4.) + 1e-13);
+  ASSERT_TRUE(cos2.has_value());
+  EXPECT_EQ(*cos2, (RationalSqrt2{2, 1, 4}));
+  EXPECT_NEAR(cos2->value(), 0.8535533905932737, 1e-16);
+
+  // sqrt(2) - 1 has a negative integer part
+  const auto silver = RationalSqrt2::recognize((2. * SQRT2_2) - 1.);
+  ASSERT_TRUE(silver.has_value());
+  EXPECT_EQ(*silver, (RationalSqrt2{-1, 1, 1}));
+
+  // denominators are not restricted to powers of two
+  const auto seventh = RationalSqrt2::recognize((1. + (2. * SQRT2_2)) / 7.);
+  ASSERT_TRUE(seventh.has_value());
+  EXPECT_EQ(*seventh, (RationalSqrt2{1, 1, 7}));
+
+  EXPECT_FALSE(RationalSqrt2::recognize(PI_4).has_value());
+  EXPECT_FALSE(RationalSqrt2::recognize(std::sqrt(3.) / 2.).has_value());
+
+  auto x = RationalSqrt2{4, 6, -8};
+  x.canonicalize();
+  EXPECT_EQ(x, (RationalSqrt2{-2, -3, 4}));
+}
+
+TEST_F(CNTest, ExactLookups) {
+  const fp num = (2. + (2. * SQRT2_2)) / 8.;
+  const fp drifted = num + (1.5 * RealNumber::eps);
+
+  // without exact lookups, numbers that drifted apart are not shared
+  MemoryManager<RealNumber> approxMM;
+  RealNumberUniqueTable approx{approxMM};
+  EXPECT_NE(approx.lookup(num), approx.lookup(drifted));
+
+  ut.setExactLookups(true);
+  auto* entry = ut.lookup(drifted);
+  EXPECT_EQ(entry->value, (RationalSqrt2{2, 1, 8}).value());
+  EXPECT_EQ(ut.lookup(num), entry);
+  EXPECT_EQ(ut.lookup(num - (1.5 * RealNumber::eps)), entry);
+  EXPECT_EQ(ut.getExactTable().size(), 1U);
+  // 0.5 and the exact number
+  EXPECT_EQ(ut.getStats().numEntries, 2U);
+
+  // numbers that are not recognized are handled up to tolerance
+  const auto irrational = std::sqrt(3.) / 2.;
+  const auto* entry2 = ut.lookup(irrational);
+  EXPECT_NE(ut.lookup(irrational + (4. * RealNumber::eps)), entry2);
+  EXPECT_EQ(ut.getExactTable().size(), 1U);
+
+  // unreferenced numbers are collected from both tables
+  ut.garbageCollect(true);
+  EXPECT_EQ(ut.getExactTable().size(), 0U);
+  EXPECT_EQ(ut.getStats().numEntries, 1U);
+}
+
 TEST_F(CNTest, LookupInNeighbouringBuckets) {
   std::clog << "Current rounding mode: " << std::numeric_limits<fp>::round_style
             << "\n";
@@ -10,11 +10,16 @@
 #include "Definitions.hpp"
 #include "circuit_optimizer/CircuitOptimizer.hpp"
 #include "dd/DDDefinitions.hpp"
+#include "dd/ExactRealNumber.hpp"
 #include "dd/FunctionalityConstruction.hpp"
 #include "dd/Node.hpp"
 #include "dd/Operations.hpp"
 #include "dd/Package.hpp"
+#include "dd/RealNumber.hpp"
 #include "dd/Simulation.hpp"
+#include "dd/statistics/SizeProfiler.hpp"
+#include "dd/statistics/StatisticsCounter.hpp"
+#include "dd/statistics/Tracer.hpp"
 #include "ir/Permutation.hpp"
 #include "ir/QuantumComputation.hpp"
 #include "ir/operations/ClassicControlledOperation.hpp"
@@ -24,13 +29,17 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <gtest/gtest.h>
 #include <iostream>
 #include <memory>
+#include <numeric>
+#include <nlohmann/json.hpp>
 #include <random>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 using namespace qc;
@@ -333,6 +342,94 @@ TEST_F(DDFunctionality, buildCircuit) {
   EXPECT_NE(ident, e);
 }
 
+TEST_F(DDFunctionality, buildCircuitParallel) {
+  qc::QuantumComputation qc(nqubits);
+  for (std::size_t i = 0U; i < 10U; ++i) {
+    for (qc::Qubit q = 0U; q < nqubits; ++q) {
+      qc.u(dist(mt), dist(mt), dist(mt), q);
+    }
+    qc.cx(0, 1);
+    qc.swap(1, 2);
+    qc.crz(dist(mt), 3, 2);
+    qc.mcx({0, 2}, 3);
+  }
+  qc.outputPermutation[0] = 1;
+  qc.outputPermutation[1] = 0;
+
+  const auto sequential = buildFunctionality(&qc, *dd);
+  for (const auto nthreads : {1U, 2U, 3U, 4U, 7U}) {
+    const auto parallel = buildFunctionalityParallel(&qc, *dd, nthreads);
+    EXPECT_EQ(sequential, parallel) << "nthreads = " << nthreads;
+    dd->decRef(parallel);
+  }
+  dd->decRef(sequential);
+}
+
+TEST_F(DDFunctionality, buildCircuitParallelWithAncillaries) {
+  qc::QuantumComputation qc(nqubits);
+  for (std::size_t i = 0U; i < 10U; ++i) {
+    for (qc::Qubit q = 0U; q < nqubits; ++q) {
+      qc.u(dist(mt), dist(mt), dist(mt), q);
+    }
+    qc.cx(0, 3);
+    qc.swap(1, 3);
+    qc.crz(dist(mt), 2, 0);
+  }
+  qc.setLogicalQubitAncillary(3);
+  qc.setLogicalQubitGarbage(3);
+  qc.setLogicalQubitGarbage(2);
+
+  const auto sequential = buildFunctionality(&qc, *dd);
+  for (const auto nthreads : {2U, 3U, 4U}) {
+    const auto parallel = buildFunctionalityParallel(&qc, *dd, nthreads);
+    EXPECT_EQ(sequential, parallel) << "nthreads = " << nthreads;
+    dd->decRef(parallel);
+  }
+  dd->decRef(sequential);
+}
+
+TEST_F(DDFunctionality, operationDDCache) {
+  if constexpr (!dd::STATISTICS_ENABLED) {
+    GTEST_SKIP() << "DD package statistics are disabled";
+  }
+  const auto theta = dist(mt);
+  const auto rz = qc::StandardOperation(0, 2, qc::RZ, {theta});
+  const auto& stats = dd->operationTable.getStats();
+
+  const auto first = getDD(&rz, *dd);
+  EXPECT_EQ(stats.lookups, 1U);
+  EXPECT_EQ(stats.hits, 0U);
+  EXPECT_EQ(stats.numEntries, 1U);
+
+  // an identical operation is served from the cache
+  const auto same = qc::StandardOperation(0, 2, qc::RZ, {theta});
+  EXPECT_EQ(getDD(&same, *dd), first);
+  EXPECT_EQ(stats.hits, 1U);
+
+  // cached DDs survive regular garbage collection
+  dd->garbageCollect();
+  EXPECT_EQ(getDD(&rz, *dd), first);
+  EXPECT_EQ(stats.hits, 2U);
+
+  // the inverse, a different parameter, and a permuted target are distinct
+  const auto inverse = getInverseDD(&rz, *dd);
+  EXPECT_NE(inverse, first);
+  const auto other = qc::StandardOperation(0, 2, qc::RZ, {theta + 1.});
+  EXPECT_NE(getDD(&other, *dd), first);
+  qc::Permutation perm{};
+  perm[0] = 1;
+  perm[1] = 0;
+  perm[2] = 2;
+  EXPECT_NE(getDD(&rz, *dd, perm), first);
+  EXPECT_EQ(stats.hits, 2U);
+  EXPECT_EQ(stats.numEntries, 4U);
+
+  // forced garbage collection releases all cached DDs
+  dd->garbageCollect(true);
+  EXPECT_EQ(stats.numEntries, 0U);
+  EXPECT_EQ(dd->cn.realCount(), initialComplexCount);
+}
+
 TEST_F(DDFunctionality, nonUnitary) {
   const qc::QuantumComputation qc{};
   auto dummyMap = Permutation{};
@@ -596,3 +693,272 @@ TEST_F(DDFunctionality, dynamicCircuitProbabilityVectorExtractionWithSWAP) {
   EXPECT_EQ(value, 1.);
   EXPECT_EQ(key, 0b01);
 }
+
+TEST_F(DDFunctionality, TracedSimulation) {
+  qc::QuantumComputation qc(nqubits);
+  qc.h(0U);
+  for (qc::Qubit q = 1U; q < nqubits; ++q) {
+    qc.cx(0U, q);
+  }
+  qc.rz(dist(mt), 1U);
+
+  dd::Tracer tracer{};
+  dd->setTracer(&tracer);
+  auto in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  const auto out = simulate(&qc, in, *dd);
+  dd->garbageCollect(true);
+  dd->setTracer(nullptr);
+
+  std::size_t operations = 0U;
+  std::size_t collections = 0U;
+  for (const auto& event : tracer.getEvents()) {
+    EXPECT_GE(event.duration, 0.);
+    EXPECT_LE(event.computeTableHits, event.computeTableLookups);
+    if (event.type == dd::TraceEvent::Type::Operation) {
+      ++operations;
+    } else {
+      ++collections;
+    }
+  }
+  EXPECT_EQ(operations, qc.getNops());
+  EXPECT_GE(collections, 1U);
+  const auto& last = tracer.getEvents().back();
+  EXPECT_EQ(last.type, dd::TraceEvent::Type::GarbageCollection);
+
+  std::size_t lastSize = 0U;
+  for (const auto& event : tracer.getEvents()) {
+    if (event.type == dd::TraceEvent::Type::Operation) {
+      lastSize = event.ddSize;
+    }
+  }
+  EXPECT_EQ(lastSize, out.size());
+
+  std::stringstream csv{};
+  tracer.exportCSV(csv);
+  std::size_t lines = 0U;
+  for (std::string line; std::getline(csv, line);) {
+    ++lines;
+  }
+  EXPECT_EQ(lines, tracer.getEvents().size() + 1U);
+
+  std::stringstream chrome{};
+  tracer.exportChromeTrace(chrome);
+  const auto json = nlohmann::json::parse(chrome.str());
+  EXPECT_GE(json.at("traceEvents").size(), tracer.getEvents().size());
+  EXPECT_EQ(json.at("traceEvents").at(0).at("ph"), "X");
+  dd->decRef(out);
+}
+
+TEST_F(DDFunctionality, SizeProfile) {
+  qc::QuantumComputation qc(nqubits);
+  qc.h(0U);
+  for (qc::Qubit q = 1U; q < nqubits; ++q) {
+    qc.cx(0U, q);
+  }
+  for (auto q = static_cast<qc::Qubit>(nqubits - 1U); q > 0U; --q) {
+    qc.cx(0U, q);
+  }
+  qc.h(0U);
+  qc.swap(0U, 1U);
+
+  dd::SizeProfiler profiler{};
+  dd->setSizeProfiler(&profiler);
+  // the zero state is returned with a reference count of one
+  const auto in = dd->makeZeroState(nqubits);
+  const auto out = simulate(&qc, in, *dd);
+  dd->setSizeProfiler(nullptr);
+
+  // one sample per operation (including the virtual SWAP)
+  const auto& samples = profiler.getSamples();
+  ASSERT_EQ(samples.size(), qc.getNops());
+  EXPECT_EQ(samples.front().name, "h");
+  EXPECT_EQ(samples.back().nodes, out.size() - 1U);
+  for (const auto& sample : samples) {
+    ASSERT_EQ(sample.nodesPerLevel.size(), nqubits);
+    EXPECT_EQ(sample.nodes, std::accumulate(sample.nodesPerLevel.begin(),
+                                            sample.nodesPerLevel.end(),
+                                            std::size_t{0U}));
+  }
+
+  // the GHZ state after the first CX cascade is the largest DD
+  const auto report = profiler.report(1.);
+  EXPECT_EQ(report.peakOperation, nqubits - 1U);
+  EXPECT_EQ(report.peakNodes, 2U * nqubits - 1U);
+  ASSERT_EQ(report.ranges.size(), 1U);
+  EXPECT_EQ(report.ranges.front().first, nqubits - 1U);
+  EXPECT_EQ(report.ranges.front().last, nqubits - 1U);
+  EXPECT_EQ(report.ranges.front().maxOperation, nqubits - 1U);
+  // the size starts growing with the first CX gate
+  EXPECT_EQ(report.ranges.front().growthStart, 0U);
+
+  std::stringstream summary{};
+  report.print(summary, samples);
+  EXPECT_NE(summary.str().find("Peak of"), std::string::npos);
+
+  std::stringstream csv{};
+  profiler.exportCSV(csv);
+  std::size_t lines = 0U;
+  for (std::string line; std::getline(csv, line);) {
+    ++lines;
+  }
+  EXPECT_EQ(lines, samples.size() + 1U);
+
+  // names are quoted like those of the tracer
+  profiler.record("u(\"a\",b)", {});
+  std::stringstream quoted{};
+  profiler.exportCSV(quoted);
+  EXPECT_NE(quoted.str().find(",\"u(\"\"a\"\",b)\","), std::string::npos);
+  dd->decRef(out);
+}
+
+TEST_F(DDFunctionality, ExactCliffordTWeights) {
+  // a random Clifford+T circuit (short enough for all weights to have small
+  // exact representations)
+  std::mt19937_64 gen(12345U);
+  std::uniform_int_distribution<std::size_t> gateDist(0U, 4U);
+  std::uniform_int_distribution<qc::Qubit> qubitDist(
+      0U, static_cast<qc::Qubit>(nqubits - 1U));
+  qc::QuantumComputation qc(nqubits);
+  for (std::size_t i = 0U; i < 100U; ++i) {
+    const auto target = qubitDist(gen);
+    switch (gateDist(gen)) {
+    case 0U:
+      qc.h(target);
+      break;
+    case 1U:
+      qc.t(target);
+      break;
+    case 2U:
+      qc.tdg(target);
+      break;
+    case 3U:
+      qc.s(target);
+      break;
+    default:
+      qc.cx(static_cast<qc::Qubit>((target + 1U) % nqubits), target);
+      break;
+    }
+  }
+  auto inverse = qc;
+  inverse.invert();
+
+  // the number of distinct real numbers of a functionality that are not
+  // stored with their correctly rounded exact value
+  const auto inexactWeights = [](const dd::mEdge& root) {
+    std::unordered_set<const dd::RealNumber*> visited{};
+    std::size_t inexact = 0U;
+    std::vector<const dd::mNode*> stack{root.p};
+    while (!stack.empty()) {
+      const auto* node = stack.back();
+      stack.pop_back();
+      for (const auto& edge : node->e) {
+        for (const auto* part : {edge.w.r, edge.w.i}) {
+          const auto val = std::abs(dd::RealNumber::val(part));
+          if (dd::RealNumber::approximatelyZero(val) ||
+              !visited.insert(dd::RealNumber::getAlignedPointer(part))
+                   .second) {
+            continue;
+          }
+          const auto x = dd::RationalSqrt2::recognize(val);
+          if (!x.has_value() || x->value() != val) {
+            ++inexact;
+          }
+        }
+        if (!edge.isTerminal()) {
+          stack.emplace_back(edge.p);
+        }
+      }
+    }
+    return inexact;
+  };
+
+  auto exact = std::make_unique<dd::CliffordTDDPackage>(nqubits);
+  ASSERT_TRUE(exact->cUniqueTable.exactLookupsEnabled());
+  const auto u = buildFunctionality(&qc, *exact);
+  const auto uInv = buildFunctionality(&inverse, *exact);
+  const auto product = exact->multiply(u, uInv);
+  EXPECT_TRUE(product.isIdentity(false));
+  EXPECT_GT(exact->cUniqueTable.getExactTable().size(), 0U);
+
+  // all weights of the functionality are represented exactly, whereas the
+  // default package keeps the rounding errors of the first computation that
+  // produced a number
+  EXPECT_EQ(inexactWeights(u), 0U);
+  const auto reference = buildFunctionality(&qc, *dd);
+  EXPECT_EQ(reference.size(), u.size());
+  EXPECT_GT(inexactWeights(reference), 0U);
+  dd->decRef(reference);
+}
+
+TEST_F(DDFunctionality, BatchedSimulation) {
+  qc::QuantumComputation qc(nqubits);
+  qc.h(0);
+  qc.cx(0, 1);
+  qc.rz(0.4, 1);
+  qc.swap(1, 3);
+  qc.ry(1.1, 2);
+  qc.cx(2, 3);
+  qc.t(3);
+  qc.ecr(0, 2);
+
+  // all basis states and a superposition (which shares most of its nodes)
+  std::vector<qc::VectorDD> inputs{};
+  for (std::size_t i = 0U; i < (1ULL << nqubits); ++i) {
+    std::vector<bool> bits(nqubits);
+    for (std::size_t q = 0U; q < nqubits; ++q) {
+      bits[q] = ((i >> q) & 1U) != 0U;
+    }
+    inputs.emplace_back(dd->makeBasisState(nqubits, bits));
+  }
+  inputs.emplace_back(dd->makeBasisState(
+      nqubits, {dd::BasisStates::plus, dd::BasisStates::zero,
+                dd::BasisStates::right, dd::BasisStates::one}));
+
+  std::vector<qc::VectorDD> expected{};
+  for (const auto& in : inputs) {
+    dd->incRef(in);
+    expected.emplace_back(simulate(&qc, in, *dd));
+  }
+  dd::Tracer tracer{};
+  dd->setTracer(&tracer);
+  dd::SizeProfiler profiler{};
+  dd->setSizeProfiler(&profiler);
+  const auto results = simulate(&qc, inputs, *dd);
+  dd->setSizeProfiler(nullptr);
+  dd->setTracer(nullptr);
+  ASSERT_EQ(results.size(), inputs.size());
+
+  // directly applied gates are traced for every state, the ECR gate is
+  // multiplied with the whole batch at once, and the profile has one sample
+  // per operation (including the virtual SWAP)
+  std::size_t operations = 0U;
+  for (const auto& event : tracer.getEvents()) {
+    if (event.type == dd::TraceEvent::Type::Operation) {
+      ++operations;
+    }
+  }
+  EXPECT_EQ(operations, ((qc.getNops() - 2U) * inputs.size()) + 1U);
+  EXPECT_EQ(tracer.getEvents().back().name, "ecr");
+  ASSERT_EQ(profiler.getSamples().size(), qc.getNops());
+  EXPECT_EQ(profiler.getSamples().at(3U).name, "swap");
+  for (std::size_t i = 0U; i < results.size(); ++i) {
+    const auto actual = results[i].getVector();
+    const auto reference = expected[i].getVector();
+    for (std::size_t j = 0U; j < reference.size(); ++j) {
+      EXPECT_NEAR(actual[j].real(), reference[j].real(), 1e-10);
+      EXPECT_NEAR(actual[j].imag(), reference[j].imag(), 1e-10);
+    }
+    dd->decRef(results[i]);
+    dd->decRef(expected[i]);
+  }
+
+  // zero vectors and repeated operands are handled within a batch
+  const auto gate = getDD(qc.at(0).get(), *dd);
+  const auto zero = dd->makeZeroState(nqubits);
+  const auto products = dd->multiply(gate, {zero, qc::VectorDD::zero(), zero});
+  EXPECT_EQ(products[0U], dd->multiply(gate, zero));
+  EXPECT_TRUE(products[1U].w.exactlyZero());
+  EXPECT_EQ(products[2U], products[0U]);
+  dd->decRef(zero);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/Entanglement.hpp"
+#include "dd/Package.hpp"
+#include "dd/Simulation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "test_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(DDEntanglement, ProductState) {
+  constexpr std::size_t nqubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  qc::QuantumComputation qc(nqubits);
+  for (qc::Qubit i = 0U; i < nqubits; ++i) {
+    qc.ry(0.3 * static_cast<double>(i + 1U), i);
+  }
+  const auto state = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd);
+
+  for (std::size_t cut = 0U; cut <= nqubits; ++cut) {
+    const auto coefficients = dd::schmidtCoefficients(state, cut);
+    ASSERT_EQ(coefficients.size(), 1U);
+    EXPECT_NEAR(coefficients[0], 1., 1e-10);
+    EXPECT_NEAR(dd::entanglementEntropy(state, cut), 0., 1e-10);
+  }
+  EXPECT_THROW(static_cast<void>(dd::entanglementEntropy(state, nqubits + 1U)),
+               std::invalid_argument);
+}
+
+TEST(DDEntanglement, GHZState) {
+  constexpr std::size_t nqubits = 5U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  qc::QuantumComputation qc(nqubits);
+  qc.h(0);
+  for (qc::Qubit i = 1U; i < nqubits; ++i) {
+    qc.cx(0, i);
+  }
+  const auto state = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd);
+
+  const auto coefficients = dd::schmidtCoefficients(state, 2U);
+  ASSERT_EQ(coefficients.size(), 2U);
+  EXPECT_NEAR(coefficients[0], dd::SQRT2_2, 1e-10);
+  EXPECT_NEAR(coefficients[1], dd::SQRT2_2, 1e-10);
+
+  const auto profile = dd::entanglementProfile(state);
+  ASSERT_EQ(profile.size(), nqubits + 1U);
+  EXPECT_NEAR(profile.front(), 0., 1e-10);
+  EXPECT_NEAR(profile.back(), 0., 1e-10);
+  for (std::size_t cut = 1U; cut < nqubits; ++cut) {
+    EXPECT_NEAR(profile[cut], 1., 1e-10);
+  }
+}
+
+TEST(DDEntanglement, BellPairsAcrossCuts) {
+  // qubit i is entangled with qubit i + 3, so k pairs cross the cut k
+  constexpr std::size_t nqubits = 6U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  qc::QuantumComputation qc(nqubits);
+  for (qc::Qubit i = 0U; i < 3U; ++i) {
+    qc.h(i);
+    qc.cx(i, i + 3U);
+  }
+  const auto state = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd);
+
+  const auto profile = dd::entanglementProfile(state);
+  const std::vector<double> expected{0., 1., 2., 3., 2., 1., 0.};
+  ASSERT_EQ(profile.size(), expected.size());
+  for (std::size_t cut = 0U; cut < expected.size(); ++cut) {
+    EXPECT_NEAR(profile[cut], expected[cut], 1e-10);
+  }
+}
+
+TEST(DDEntanglement, RandomStateMatchesPurity) {
+  constexpr std::size_t nqubits = 5U;
+  constexpr std::size_t dim = 1ULL << nqubits;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  std::mt19937_64 mt(42U);
+  const auto state =
+      dd->makeStateFromVector(dd::randomStateVector(nqubits, mt));
+  const auto vec = state.getVector();
+  dd::fp norm = 0.;
+  for (const auto& amplitude : vec) {
+    norm += std::norm(amplitude);
+  }
+
+  const auto profile = dd::entanglementProfile(state);
+  for (std::size_t cut = 1U; cut < nqubits; ++cut) {
+    // the purity Tr(ρ^2) of the reduced density matrix of the lower qubits
+    const std::size_t lower = 1ULL << cut;
+    const std::size_t upper = dim / lower;
+    dd::fp purity = 0.;
+    for (std::size_t i = 0U; i < lower; ++i) {
+      for (std::size_t j = 0U; j < lower; ++j) {
+        std::complex<dd::fp> rho = 0.;
+        for (std::size_t k = 0U; k < upper; ++k) {
+          rho += vec[(k * lower) + i] * std::conj(vec[(k * lower) + j]);
+        }
+        purity += std::norm(rho / norm);
+      }
+    }
+
+    const auto coefficients = dd::schmidtCoefficients(state, cut);
+    EXPECT_LE(coefficients.size(), std::min(lower, upper));
+    dd::fp sum = 0.;
+    dd::fp sumOfSquares = 0.;
+    dd::fp entropy = 0.;
+    for (const auto c : coefficients) {
+      sum += c * c;
+      sumOfSquares += c * c * c * c;
+      entropy -= c * c * std::log2(c * c);
+    }
+    EXPECT_NEAR(sum, 1., 1e-10);
+    EXPECT_NEAR(sumOfSquares, purity, 1e-10);
+    EXPECT_NEAR(profile[cut], entropy, 1e-10);
+    EXPECT_NEAR(dd::entanglementEntropy(state, cut), entropy, 1e-10);
+  }
+}
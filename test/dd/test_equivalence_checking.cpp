@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/EquivalenceChecking.hpp"
+#include "dd/FunctionalityConstruction.hpp"
+#include "dd/Package.hpp"
+#include "dd/Simulation.hpp"
+#include "ir/QuantumComputation.hpp"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+constexpr auto SCHEMES = {dd::AlternatingScheme::OneToOne,
+                          dd::AlternatingScheme::Proportional,
+                          dd::AlternatingScheme::Lookahead};
+
+/// Layers of single-qubit rotations and a ladder of entangling gates
+qc::QuantumComputation layeredCircuit(const std::size_t nqubits) {
+  qc::QuantumComputation qc(nqubits);
+  const auto n = static_cast<qc::Qubit>(nqubits);
+  for (std::size_t layer = 0U; layer < 3U; ++layer) {
+    for (qc::Qubit i = 0U; i < n; ++i) {
+      qc.ry(0.1 * static_cast<double>(i + 1U) + static_cast<double>(layer), i);
+      qc.rz(0.3 * static_cast<double>(layer + 1U), i);
+    }
+    for (qc::Qubit i = 0U; i + 1U < n; ++i) {
+      qc.cz(i, i + 1U);
+    }
+  }
+  return qc;
+}
+
+/// The same circuit with every CZ expressed as H·CX·H
+qc::QuantumComputation decomposedCircuit(const std::size_t nqubits) {
+  qc::QuantumComputation qc(nqubits);
+  const auto n = static_cast<qc::Qubit>(nqubits);
+  for (std::size_t layer = 0U; layer < 3U; ++layer) {
+    for (qc::Qubit i = 0U; i < n; ++i) {
+      qc.ry(0.1 * static_cast<double>(i + 1U) + static_cast<double>(layer), i);
+      qc.rz(0.3 * static_cast<double>(layer + 1U), i);
+    }
+    for (qc::Qubit i = 0U; i + 1U < n; ++i) {
+      qc.h(i + 1U);
+      qc.cx(i, i + 1U);
+      qc.h(i + 1U);
+    }
+  }
+  return qc;
+}
+} // namespace
+
+TEST(DDEquivalenceChecking, DecomposedCircuitIsEquivalent) {
+  constexpr std::size_t nqubits = 6U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto qc1 = layeredCircuit(nqubits);
+  const auto qc2 = decomposedCircuit(nqubits);
+
+  const auto u = dd::buildFunctionality(&qc1, *dd);
+  const auto functionalitySize = u.size();
+  dd->decRef(u);
+
+  for (const auto scheme : SCHEMES) {
+    dd::EquivalenceCheckingConfiguration config{};
+    config.scheme = scheme;
+    const auto result = dd::checkEquivalence(qc1, qc2, *dd, config);
+    EXPECT_EQ(result.equivalence, dd::EquivalenceCriterion::Equivalent);
+    EXPECT_EQ(result.appliedLeft, qc1.size());
+    EXPECT_EQ(result.appliedRight, qc2.size());
+    // the intermediate DD stays much smaller than the functionality
+    EXPECT_LT(4U * result.peakNodes, functionalitySize);
+  }
+}
+
+TEST(DDEquivalenceChecking, SwapGatesAreExecutedVirtually) {
+  auto dd = std::make_unique<dd::Package<>>(3U);
+  qc::QuantumComputation qc1(3U);
+  qc1.h(0);
+  qc1.swap(0, 2);
+  qc1.cx(2, 1);
+  qc::QuantumComputation qc2(3U);
+  qc2.h(0);
+  qc2.cx(0, 2);
+  qc2.cx(2, 0);
+  qc2.cx(0, 2);
+  qc2.cx(2, 1);
+
+  for (const auto scheme : SCHEMES) {
+    dd::EquivalenceCheckingConfiguration config{};
+    config.scheme = scheme;
+    EXPECT_EQ(dd::checkEquivalence(qc1, qc2, *dd, config).equivalence,
+              dd::EquivalenceCriterion::Equivalent);
+  }
+}
+
+TEST(DDEquivalenceChecking, DetectsNonEquivalence) {
+  constexpr std::size_t nqubits = 6U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto qc1 = layeredCircuit(nqubits);
+  auto qc2 = decomposedCircuit(nqubits);
+  qc2.t(3);
+
+  for (const auto scheme : SCHEMES) {
+    dd::EquivalenceCheckingConfiguration config{};
+    config.scheme = scheme;
+    EXPECT_EQ(dd::checkEquivalence(qc1, qc2, *dd, config).equivalence,
+              dd::EquivalenceCriterion::NotEquivalent);
+  }
+
+  qc::QuantumComputation cx(2U);
+  cx.cx(0, 1);
+  qc::QuantumComputation reversed(2U);
+  reversed.cx(1, 0);
+  EXPECT_EQ(dd::checkEquivalence(cx, reversed, *dd).equivalence,
+            dd::EquivalenceCriterion::NotEquivalent);
+}
+
+TEST(DDEquivalenceChecking, GlobalPhase) {
+  auto dd = std::make_unique<dd::Package<>>(1U);
+  // Z·X = iY
+  qc::QuantumComputation qc1(1U);
+  qc1.x(0);
+  qc1.z(0);
+  qc::QuantumComputation qc2(1U);
+  qc2.y(0);
+  EXPECT_EQ(dd::checkEquivalence(qc1, qc2, *dd).equivalence,
+            dd::EquivalenceCriterion::EquivalentUpToGlobalPhase);
+}
+
+TEST(DDEquivalenceChecking, NodeLimitAbortsCheck) {
+  constexpr std::size_t nqubits = 6U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto qc1 = layeredCircuit(nqubits);
+  const auto qc2 = decomposedCircuit(nqubits);
+
+  dd::EquivalenceCheckingConfiguration config{};
+  config.maxNodes = 2U;
+  const auto result = dd::checkEquivalence(qc1, qc2, *dd, config);
+  EXPECT_EQ(result.equivalence, dd::EquivalenceCriterion::NoInformation);
+  EXPECT_GT(result.peakNodes, config.maxNodes);
+  EXPECT_LT(result.appliedLeft + result.appliedRight, qc1.size() + qc2.size());
+}
+
+TEST(DDEquivalenceChecking, InvalidInput) {
+  auto dd = std::make_unique<dd::Package<>>(2U);
+  qc::QuantumComputation qc1(1U);
+  qc1.h(0);
+  qc::QuantumComputation qc2(2U);
+  qc2.h(0);
+  EXPECT_THROW(dd::checkEquivalence(qc1, qc2, *dd), std::invalid_argument);
+
+  qc::QuantumComputation measured(1U, 1U);
+  measured.h(0);
+  measured.measure(0, 0);
+  EXPECT_THROW(dd::checkEquivalence(measured, qc1, *dd), std::invalid_argument);
+}
+
+TEST(DDEquivalenceChecking, FalsificationFindsCounterexample) {
+  constexpr std::size_t nqubits = 6U;
+  const auto qc1 = layeredCircuit(nqubits);
+  auto qc2 = decomposedCircuit(nqubits);
+  qc2.t(3);
+
+  dd::FalsificationConfiguration config{};
+  config.seed = 42U;
+  config.nthreads = 1U;
+  const auto sequential = dd::falsifyEquivalence(qc1, qc2, config);
+  ASSERT_TRUE(sequential.falsified);
+  EXPECT_EQ(sequential.counterexample.size(), nqubits);
+  EXPECT_LT(sequential.fidelity, config.fidelityThreshold);
+  EXPECT_LT(sequential.simulations, config.stimuli);
+
+  // the counterexample does not depend on the number of threads
+  config.nthreads = 4U;
+  const auto parallel = dd::falsifyEquivalence(qc1, qc2, config);
+  ASSERT_TRUE(parallel.falsified);
+  EXPECT_EQ(parallel.counterexample, sequential.counterexample);
+  EXPECT_NEAR(parallel.fidelity, sequential.fidelity, 1e-12);
+
+  // the counterexample distinguishes the circuits
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto out1 = dd::simulate(
+      &qc1, dd->makeBasisState(nqubits, sequential.counterexample), *dd);
+  const auto out2 = dd::simulate(
+      &qc2, dd->makeBasisState(nqubits, sequential.counterexample), *dd);
+  EXPECT_NEAR(dd->fidelity(out1, out2), sequential.fidelity, 1e-10);
+}
+
+TEST(DDEquivalenceChecking, FalsificationOfEquivalentCircuits) {
+  constexpr std::size_t nqubits = 6U;
+  const auto qc1 = layeredCircuit(nqubits);
+  const auto qc2 = decomposedCircuit(nqubits);
+
+  dd::FalsificationConfiguration config{};
+  config.seed = 42U;
+  config.nthreads = 3U;
+  const auto result = dd::falsifyEquivalence(qc1, qc2, config);
+  EXPECT_FALSE(result.falsified);
+  EXPECT_TRUE(result.counterexample.empty());
+  EXPECT_EQ(result.simulations, config.stimuli);
+}
+
+TEST(DDEquivalenceChecking, FalsificationDoesNotLeakStates) {
+  constexpr std::size_t nqubits = 6U;
+  const auto qc1 = layeredCircuit(nqubits);
+  const auto qc2 = decomposedCircuit(nqubits);
+
+  dd::FalsificationConfiguration config{};
+  config.seed = 42U;
+  config.nthreads = 1U;
+  config.stimuli = 4U;
+  const auto few = dd::falsifyEquivalence(qc1, qc2, config);
+  config.stimuli = 64U;
+  const auto many = dd::falsifyEquivalence(qc1, qc2, config);
+  ASSERT_EQ(many.simulations, config.stimuli);
+  EXPECT_EQ(many.activeNodes, few.activeNodes);
+  EXPECT_EQ(many.activeNodes, 0U);
+}
+
+TEST(DDEquivalenceChecking, FalsificationWithQuantumStimuli) {
+  // the circuits only differ by a relative phase
+  qc::QuantumComputation qc1(2U);
+  qc1.z(0);
+  const qc::QuantumComputation qc2(2U);
+
+  dd::FalsificationConfiguration config{};
+  config.seed = 42U;
+  config.type = dd::StimuliType::Classical;
+  EXPECT_FALSE(dd::falsifyEquivalence(qc1, qc2, config).falsified);
+  config.type = dd::StimuliType::LocalQuantum;
+  EXPECT_TRUE(dd::falsifyEquivalence(qc1, qc2, config).falsified);
+}
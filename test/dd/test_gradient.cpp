@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/GateMatrixDefinitions.hpp"
+#include "dd/Gradient.hpp"
+#include "dd/Package.hpp"
+#include "dd/Simulation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Expression.hpp"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+qc::Symbolic symbol(const sym::Variable& var, const qc::fp coeff = 1.) {
+  return qc::Symbolic(sym::Term<qc::fp>(var, coeff));
+}
+} // namespace
+
+TEST(DDGradient, MatchesFiniteDifferences) {
+  constexpr std::size_t nqubits = 3U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  std::vector<sym::Variable> vars{};
+  for (std::size_t i = 0U; i < 8U; ++i) {
+    vars.emplace_back("x" + std::to_string(i));
+  }
+
+  // covers rotations, phases, multi-parameter gates, controlled and two-target
+  // gates, a virtual SWAP, and a variable shared by two gates
+  qc::QuantumComputation qc(nqubits);
+  qc.ry(symbol(vars[0]), 0);
+  qc.rx(symbol(vars[1]), 1);
+  qc.h(2);
+  qc.cx(0, 1);
+  qc.u(symbol(vars[2]), symbol(vars[3]), 0.4, 2);
+  qc.rzz(symbol(vars[4]), 1, 2);
+  qc.swap(0, 2);
+  qc.crx(symbol(vars[5]), 0, 1);
+  qc.p(symbol(vars[6]), 0);
+  qc.xx_plus_yy(symbol(vars[7]), 0.3, 0, 1);
+  qc.rz(symbol(vars[0], 2.), 2);
+  qc.ry(symbol(vars[6], -0.5), 1);
+
+  // H = Z_0 Z_1 + X_2
+  const auto zz = dd->multiply(dd->makeGateDD(dd::Z_MAT, 0),
+                               dd->makeGateDD(dd::Z_MAT, 1));
+  const auto observable = dd->add(zz, dd->makeGateDD(dd::X_MAT, 2));
+  dd->incRef(observable);
+
+  qc::VariableAssignment assignment{};
+  for (std::size_t i = 0U; i < vars.size(); ++i) {
+    assignment[vars[i]] = 0.3 + (0.45 * static_cast<qc::fp>(i));
+  }
+  const auto expectation = [&](const qc::VariableAssignment& values) {
+    const auto instantiated = qc.instantiate(values);
+    const auto state =
+        dd::simulate(&instantiated, dd->makeZeroState(nqubits), *dd);
+    const auto value = dd->expectationValue(observable, state);
+    dd->decRef(state);
+    return value;
+  };
+
+  const auto in = dd->makeZeroState(nqubits);
+  const auto result =
+      dd::computeGradient(qc, in, observable, assignment, *dd);
+  EXPECT_NEAR(result.expectationValue, expectation(assignment), 1e-10);
+  ASSERT_EQ(result.gradient.size(), vars.size());
+
+  constexpr qc::fp h = 1e-5;
+  for (const auto& var : vars) {
+    auto plus = assignment;
+    plus[var] += h;
+    auto minus = assignment;
+    minus[var] -= h;
+    const auto expected = (expectation(plus) - expectation(minus)) / (2. * h);
+    EXPECT_NEAR(result.gradient.at(var), expected, 1e-6) << var.getName();
+  }
+  dd->decRef(in);
+  dd->decRef(observable);
+}
+
+TEST(DDGradient, InvalidInput) {
+  auto dd = std::make_unique<dd::Package<>>(1U);
+  const auto in = dd->makeZeroState(1U);
+  const auto observable = dd->makeGateDD(dd::Z_MAT, 0);
+  const sym::Variable var("x");
+
+  qc::QuantumComputation measured(1U, 1U);
+  measured.rx(symbol(var), 0);
+  measured.measure(0, 0);
+  EXPECT_THROW(dd::computeGradient(measured, in, observable, {{var, 0.1}}, *dd),
+               std::invalid_argument);
+
+  qc::QuantumComputation qc(1U);
+  qc.rx(symbol(var), 0);
+  EXPECT_THROW(dd::computeGradient(qc, in, observable, {}, *dd),
+               std::invalid_argument);
+}
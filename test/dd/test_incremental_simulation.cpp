@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/IncrementalSimulation.hpp"
+#include "dd/Package.hpp"
+#include "dd/Simulation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "ir/operations/Expression.hpp"
+
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+/// A hardware-efficient ansatz with one variable per rotation
+qc::QuantumComputation ansatz(const std::size_t nqubits,
+                              const std::size_t layers,
+                              std::vector<sym::Variable>& variables) {
+  qc::QuantumComputation qc(nqubits);
+  const auto n = static_cast<qc::Qubit>(nqubits);
+  for (std::size_t layer = 0U; layer < layers; ++layer) {
+    for (qc::Qubit i = 0U; i < n; ++i) {
+      const auto& var = variables.emplace_back(
+          "t" + std::to_string(layer) + "_" + std::to_string(i));
+      qc.ry(qc::Symbolic(sym::Term<qc::fp>(var)), i);
+    }
+    for (qc::Qubit i = 0U; i + 1U < n; ++i) {
+      qc.cx(i, i + 1U);
+    }
+  }
+  qc.swap(0, n - 1U);
+  qc.rz(qc::Symbolic(sym::Term<qc::fp>(variables.front(), 0.5)), 0);
+  return qc;
+}
+
+qc::VariableAssignment assign(const std::vector<sym::Variable>& variables,
+                              const qc::fp offset) {
+  qc::VariableAssignment assignment{};
+  for (std::size_t i = 0U; i < variables.size(); ++i) {
+    assignment[variables[i]] = offset + (0.1 * static_cast<qc::fp>(i));
+  }
+  return assignment;
+}
+} // namespace
+
+TEST(DDIncrementalSimulation, MatchesRegularSimulation) {
+  constexpr std::size_t nqubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  std::vector<sym::Variable> variables{};
+  auto qc = ansatz(nqubits, 3U, variables);
+  dd::IncrementalSimulator simulator(qc, dd->makeZeroState(nqubits), *dd, 4U);
+
+  const auto check = [&](const qc::VariableAssignment& assignment) {
+    const auto state = simulator.simulate(assignment);
+    const auto instantiated = qc.instantiate(assignment);
+    const auto expected =
+        dd::simulate(&instantiated, dd->makeZeroState(nqubits), *dd);
+    EXPECT_NEAR(dd->fidelity(state, expected), 1., 1e-10);
+    dd->decRef(state);
+    dd->decRef(expected);
+  };
+
+  auto assignment = assign(variables, 0.2);
+  check(assignment);
+  EXPECT_EQ(simulator.appliedOperations(), qc.size());
+
+  // only the operations after the last checkpoint before the changed rotation
+  // are applied again
+  // the last variable belongs to the fourth rotation of the third layer
+  constexpr std::size_t lastRotation = (2U * 7U) + 3U;
+  assignment[variables.back()] += 0.5;
+  check(assignment);
+  EXPECT_EQ(simulator.appliedOperations(),
+            qc.size() - ((lastRotation / 4U) * 4U));
+
+  // nothing changed
+  check(assignment);
+  EXPECT_EQ(simulator.appliedOperations(), qc.size() % 4U);
+
+  // the first variable is also used by the final rotation
+  assignment[variables.front()] -= 0.3;
+  check(assignment);
+  EXPECT_EQ(simulator.appliedOperations(), qc.size());
+}
+
+TEST(DDIncrementalSimulation, InvalidInput) {
+  auto dd = std::make_unique<dd::Package<>>(1U);
+  qc::QuantumComputation measured(1U, 1U);
+  measured.h(0);
+  measured.measure(0, 0);
+  EXPECT_THROW(
+      dd::IncrementalSimulator(measured, dd->makeZeroState(1U), *dd),
+      std::invalid_argument);
+
+  qc::QuantumComputation qc(1U);
+  const sym::Variable var("x");
+  qc.rx(qc::Symbolic(sym::Term<qc::fp>(var)), 0);
+  dd::IncrementalSimulator simulator(qc, dd->makeZeroState(1U), *dd);
+  EXPECT_THROW(static_cast<void>(simulator.simulate({})),
+               std::invalid_argument);
+}
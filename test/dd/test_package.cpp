@@ -8,6 +8,7 @@
  */
 
 #include "Definitions.hpp"
+#include "dd/ComplexNumbers.hpp"
 #include "dd/DDDefinitions.hpp"
 #include "dd/DDpackageConfig.hpp"
 #include "dd/Export.hpp"
@@ -17,10 +18,16 @@
 #include "dd/Package.hpp"
 #include "dd/RealNumber.hpp"
 #include "dd/statistics/PackageStatistics.hpp"
+#include "dd/statistics/StatisticsCounter.hpp"
+#include "dd/statistics/UniqueTableStatistics.hpp"
 #include "ir/operations/Control.hpp"
+#include "test_utils.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <complex>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
@@ -34,6 +41,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -347,9 +355,45 @@ TEST(DDPackageTest, PartialTraceKeepInnerQubits) {
   EXPECT_EQ(fullTrace, fullTraceOriginal);
 }
 
+TEST(DDPackageTest, PartialTraceOfInterleavedQubits) {
+  // Trace out the qubits 0 and 2 of a matrix that acts as the identity on
+  // qubit 2, so that level is skipped in the DD
+  constexpr std::size_t numQubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(numQubits);
+  auto u = dd->multiply(dd->makeGateDD(dd::X_MAT, 0_pc, 1),
+                        dd->makeGateDD(dd::H_MAT, 0));
+  u = dd->multiply(dd->makeGateDD(dd::ryMat(0.7), 3), u);
+  u = dd->multiply(dd->makeGateDD(dd::X_MAT, 3_pc, 1), u);
+  u = dd->multiply(dd->makeGateDD(dd::T_MAT, 3), u);
+  const std::vector<bool> eliminate{true, false, true, false};
+  const auto reduced = dd->partialTrace(u, eliminate);
+
+  const auto full = u.getMatrix(numQubits);
+  const auto actual = reduced.getMatrix(2U);
+  // the remaining qubits 1 and 3 are renumbered to 0 and 1
+  const auto index = [](const std::size_t kept, const std::size_t traced) {
+    return ((kept & 1U) << 1U) | ((kept & 2U) << 2U) | (traced & 1U) |
+           ((traced & 2U) << 1U);
+  };
+  for (std::size_t i = 0U; i < 4U; ++i) {
+    for (std::size_t j = 0U; j < 4U; ++j) {
+      std::complex<dd::fp> expected = 0.;
+      for (std::size_t t = 0U; t < 4U; ++t) {
+        expected += full[index(i, t)][index(j, t)];
+      }
+      expected /= 4.;
+      EXPECT_NEAR(actual[i][j].real(), expected.real(), 1e-10);
+      EXPECT_NEAR(actual[i][j].imag(), expected.imag(), 1e-10);
+    }
+  }
+}
+
 TEST(DDPackageTest, TraceComplexity) {
+  if constexpr (!dd::STATISTICS_ENABLED) {
+    GTEST_SKIP() << "DD package statistics are disabled";
+  }
   // Check that the full trace computation scales with the number of nodes
-  // instead of paths in the DD due to the usage of a compute table
+  // instead of paths in the DD, i.e., every node is only looked up once
   for (std::size_t numQubits = 1; numQubits <= 10; ++numQubits) {
     auto dd = std::make_unique<dd::Package<>>(numQubits);
     auto& computeTable = dd->getTraceComputeTable<dd::mNode>();
@@ -360,12 +404,15 @@ TEST(DDPackageTest, TraceComplexity) {
     }
     dd->trace(hKron, numQubits);
     const auto& stats = computeTable.getStats();
-    ASSERT_EQ(stats.lookups, 2 * numQubits - 1);
-    ASSERT_EQ(stats.hits, numQubits - 1);
+    ASSERT_EQ(stats.lookups, numQubits);
+    ASSERT_EQ(stats.hits, 0U);
   }
 }
 
 TEST(DDPackageTest, KeepBottomQubitsPartialTraceComplexity) {
+  if constexpr (!dd::STATISTICS_ENABLED) {
+    GTEST_SKIP() << "DD package statistics are disabled";
+  }
   // Check that during the trace computation, once a level is reached
   // where the remaining qubits should not be eliminated, the function does not
   // recurse further but immediately returns the current CachedEdge<Node>.
@@ -395,9 +442,11 @@ TEST(DDPackageTest, KeepBottomQubitsPartialTraceComplexity) {
 }
 
 TEST(DDPackageTest, PartialTraceComplexity) {
-  // In the worst case, the partial trace computation scales with the number of
-  // paths in the DD. This situation arises particularly when tracing out the
-  // bottom qubits.
+  if constexpr (!dd::STATISTICS_ENABLED) {
+    GTEST_SKIP() << "DD package statistics are disabled";
+  }
+  // Even when tracing out the bottom qubits, the partial trace computation
+  // scales with the number of nodes instead of paths in the DD
   const std::size_t numQubits = 9;
   auto dd = std::make_unique<dd::Package<>>(numQubits);
   auto& uniqueTable = dd->getUniqueTable<dd::mNode>();
@@ -418,11 +467,8 @@ TEST(DDPackageTest, PartialTraceComplexity) {
   dd->partialTrace(
       hKron, {true, false, false, false, false, false, false, true, true});
   for (std::size_t i = 1; i < maxNodeVal; ++i) {
-    // Check that the number of lookups scales with the number of paths in the
-    // DD
-    ASSERT_EQ(uniqueTable.getStats(i).lookups,
-              lookupValues[i] +
-                  static_cast<std::size_t>(std::pow(4, (maxNodeVal - i))));
+    // Check that a single node is created per level
+    ASSERT_EQ(uniqueTable.getStats(i).lookups, lookupValues[i] + 1U);
   }
 }
 
@@ -2386,6 +2432,9 @@ TEST(DDPackageTest, DDNodeLeakRegressionTest) {
  * anymore since terminal DD nodes were replaced by a `nullptr` pointer.
  */
 TEST(DDPackageTest, CTPerformanceRegressionTest) {
+  if constexpr (!dd::STATISTICS_ENABLED) {
+    GTEST_SKIP() << "DD package statistics are disabled";
+  }
   const auto nqubits = 1U;
   auto dd = std::make_unique<dd::Package<>>(nqubits);
 
@@ -2627,3 +2676,237 @@ TEST(DDPackageTest, ReduceGarbageIdentityBetweenTwoNodes) {
                       {0, 1, 0, 0, 0, 0, 0, 0}, {1, 0, 0, 0, 0, 0, 0, 0}};
   EXPECT_EQ(outputMatrix, expected);
 }
+
+TEST(DDPackageTest, DirectGateApplication) {
+  constexpr std::size_t nqubits = 5U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  std::mt19937_64 mt(12345U);
+  std::uniform_real_distribution<dd::fp> angle(0., 2. * dd::PI);
+
+  const auto state =
+      dd->makeStateFromVector(dd::randomStateVector(nqubits, mt));
+  dd->incRef(state);
+
+  const std::vector<qc::Controls> controlSets{
+      {}, {0_pc}, {4_nc}, {1_pc, 3_nc}, {0_nc, 1_pc, 4_pc}};
+  for (const auto& controls : controlSets) {
+    for (dd::Qubit target = 0U; target < nqubits; ++target) {
+      if (std::any_of(controls.begin(), controls.end(),
+                      [target](const auto& c) { return c.qubit == target; })) {
+        continue;
+      }
+      const auto mat = dd::uMat(angle(mt), angle(mt), angle(mt));
+      const auto direct = dd->applyGate(mat, controls, target, state);
+      const auto reference =
+          dd->multiply(dd->makeGateDD(mat, controls, target), state);
+      const auto directVec = direct.getVector();
+      const auto referenceVec = reference.getVector();
+      for (std::size_t i = 0U; i < directVec.size(); ++i) {
+        EXPECT_NEAR(directVec[i].real(), referenceVec[i].real(), 1e-10)
+            << "target " << target << ", index " << i;
+        EXPECT_NEAR(directVec[i].imag(), referenceVec[i].imag(), 1e-10)
+            << "target " << target << ", index " << i;
+      }
+    }
+  }
+  dd->decRef(state);
+}
+
+TEST(DDPackageTest, DirectDiagonalAndPermutationGateApplication) {
+  constexpr std::size_t nqubits = 5U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  std::mt19937_64 mt(54321U);
+  std::uniform_real_distribution<dd::fp> angle(0., 2. * dd::PI);
+
+  const auto state =
+      dd->makeStateFromVector(dd::randomStateVector(nqubits, mt));
+  dd->incRef(state);
+
+  const auto expectEqual = [](const dd::vEdge& direct,
+                              const dd::vEdge& reference) {
+    const auto directVec = direct.getVector();
+    const auto referenceVec = reference.getVector();
+    ASSERT_EQ(directVec.size(), referenceVec.size());
+    for (std::size_t i = 0U; i < directVec.size(); ++i) {
+      EXPECT_NEAR(directVec[i].real(), referenceVec[i].real(), 1e-10);
+      EXPECT_NEAR(directVec[i].imag(), referenceVec[i].imag(), 1e-10);
+    }
+  };
+
+  using GateKind = dd::Package<>::GateKind;
+  const std::vector<qc::Controls> controlSets{
+      {}, {0_pc}, {4_nc}, {1_pc, 3_nc}, {0_nc, 2_pc}};
+  for (const auto& controls : controlSets) {
+    const auto isControl = [&controls](const dd::Qubit q) {
+      return std::any_of(controls.begin(), controls.end(),
+                         [q](const auto& c) { return c.qubit == q; });
+    };
+    for (dd::Qubit target = 0U; target < nqubits; ++target) {
+      if (isControl(target)) {
+        continue;
+      }
+      const std::vector<std::pair<dd::GateMatrix, GateKind>> gates{
+          {dd::Z_MAT, GateKind::Diagonal},
+          {dd::S_MAT, GateKind::Diagonal},
+          {dd::T_MAT, GateKind::Diagonal},
+          {dd::rzMat(angle(mt)), GateKind::Diagonal},
+          {dd::pMat(angle(mt)), GateKind::Diagonal},
+          {dd::X_MAT, GateKind::AntiDiagonal},
+          {dd::Y_MAT, GateKind::AntiDiagonal}};
+      for (const auto& [mat, kind] : gates) {
+        const auto direct = dd->applyGate(mat, controls, target, state, kind);
+        const auto reference =
+            dd->multiply(dd->makeGateDD(mat, controls, target), state);
+        expectEqual(direct, reference);
+      }
+
+      for (dd::Qubit other = 0U; other < nqubits; ++other) {
+        if (other == target || isControl(other)) {
+          continue;
+        }
+        const auto direct = dd->applySwapGate(controls, target, other, state);
+        const auto reference = dd->multiply(
+            dd->makeTwoQubitGateDD(dd::SWAP_MAT, controls, target, other),
+            state);
+        expectEqual(direct, reference);
+      }
+    }
+  }
+  dd->decRef(state);
+}
+
+TEST(DDPackageTest, DirectGateApplicationBelowDeepTarget) {
+  // the sub-vectors below the target carry a weight of 2^-(n/2), which must not
+  // be mistaken for zero
+  constexpr std::size_t nqubits = 101U;
+  constexpr auto top = static_cast<dd::Qubit>(nqubits - 1U);
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  auto state = dd->makeZeroState(nqubits);
+  dd->incRef(state);
+  for (dd::Qubit q = 0U; q < top; ++q) {
+    const auto next = dd->applyGate(dd::H_MAT, {}, q, state);
+    dd->incRef(next);
+    dd->decRef(state);
+    state = next;
+  }
+
+  using GateKind = dd::Package<>::GateKind;
+  const auto diagonal =
+      dd->applyGate(dd::Z_MAT, {1_pc}, top, state, GateKind::Diagonal);
+  EXPECT_NEAR(dd::ComplexNumbers::mag2(diagonal.w), 1., 1e-10);
+  EXPECT_NEAR(dd->fidelity(diagonal, state), 1., 1e-10);
+  const auto general = dd->applyGate(dd::H_MAT, {1_pc}, top, state);
+  EXPECT_NEAR(dd->innerProduct(general, general).r, 1., 1e-10);
+  const auto swapped = dd->applySwapGate({0_pc}, top, 1U, state);
+  EXPECT_NEAR(dd->innerProduct(swapped, swapped).r, 1., 1e-10);
+  dd->decRef(state);
+}
+
+TEST(DDPackageTest, StatisticsCanBeReadConcurrently) {
+  static_assert(std::is_empty_v<dd::StatisticsCounter<false>>);
+  constexpr std::size_t nqubits = 6U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto& stats = dd->vUniqueTable.getStats(0U);
+
+  std::atomic<bool> done{false};
+  std::size_t observed = 0U;
+  bool monotonic = true;
+  std::thread monitor([&]() {
+    while (!done.load()) {
+      const dd::UniqueTableStatistics snapshot = stats;
+      monotonic = monotonic && snapshot.lookups >= observed;
+      observed = snapshot.lookups;
+    }
+  });
+
+  auto state = dd->makeZeroState(nqubits);
+  dd->incRef(state);
+  for (std::size_t i = 0U; i < 50U; ++i) {
+    for (dd::Qubit q = 0U; q < nqubits; ++q) {
+      auto next = dd->multiply(dd->makeGateDD(dd::H_MAT, q), state);
+      dd->incRef(next);
+      dd->decRef(state);
+      state = next;
+    }
+  }
+  done = true;
+  monitor.join();
+  dd->decRef(state);
+
+  EXPECT_TRUE(monotonic);
+  EXPECT_LE(observed, stats.lookups);
+  if constexpr (dd::STATISTICS_ENABLED) {
+    EXPECT_GT(stats.lookups, 0U);
+  } else {
+    EXPECT_EQ(stats.lookups, 0U);
+  }
+}
+
+TEST(DDPackageTest, FrozenDDIsSharedBetweenPackages) {
+  constexpr std::size_t nqubits = 6U;
+  constexpr std::size_t nworkers = 4U;
+  auto owner = std::make_unique<dd::Package<>>(nqubits);
+  auto u = owner->makeIdent();
+  owner->incRef(u);
+  for (dd::Qubit q = 0U; q < nqubits; ++q) {
+    const auto gate =
+        owner->multiply(owner->makeGateDD(dd::H_MAT, q),
+                        owner->makeGateDD(dd::ryMat(0.1 * (q + 1)), q));
+    auto next = owner->multiply(gate, u);
+    if (q > 0U) {
+      next = owner->multiply(owner->makeGateDD(dd::X_MAT, q - 1U, q), next);
+    }
+    owner->incRef(next);
+    owner->decRef(u);
+    u = next;
+  }
+  owner->freeze(u);
+  // the frozen DD survives releasing the last reference and collecting
+  owner->decRef(u);
+  owner->garbageCollect(true);
+  EXPECT_EQ(u.p->ref, std::numeric_limits<dd::RefCount>::max());
+
+  // every worker uses a different input state
+  const auto input = [](const std::size_t i) {
+    std::vector<bool> bits(nqubits, false);
+    bits[0U] = (i & 1U) != 0U;
+    bits[1U] = (i & 2U) != 0U;
+    return bits;
+  };
+  std::vector<dd::CVec> expected{};
+  for (std::size_t i = 0U; i < nworkers; ++i) {
+    const auto in = owner->makeBasisState(nqubits, input(i));
+    expected.emplace_back(owner->multiply(u, in).getVector());
+  }
+
+  std::vector<dd::CVec> results(nworkers);
+  std::vector<std::thread> workers{};
+  for (std::size_t i = 0U; i < nworkers; ++i) {
+    workers.emplace_back([&, i]() {
+      auto dd = std::make_unique<dd::Package<>>(nqubits);
+      for (std::size_t round = 0U; round < 10U; ++round) {
+        const auto in = dd->makeBasisState(nqubits, input(i));
+        const auto out = dd->multiply(u, in);
+        dd->incRef(out);
+        results[i] = out.getVector();
+        dd->decRef(out);
+        dd->decRef(in);
+        dd->garbageCollect(true);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (std::size_t i = 0U; i < nworkers; ++i) {
+    ASSERT_EQ(results[i].size(), expected[i].size());
+    for (std::size_t j = 0U; j < expected[i].size(); ++j) {
+      EXPECT_NEAR(results[i][j].real(), expected[i][j].real(), 1e-10);
+      EXPECT_NEAR(results[i][j].imag(), expected[i][j].imag(), 1e-10);
+    }
+  }
+  // the owner can still use the frozen DD after the workers are gone
+  const auto again = owner->multiply(u, owner->makeZeroState(nqubits));
+  EXPECT_EQ(again.getVector(), expected.front());
+}
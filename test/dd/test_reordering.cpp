@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/DDDefinitions.hpp"
+#include "dd/FunctionalityConstruction.hpp"
+#include "dd/GateMatrixDefinitions.hpp"
+#include "dd/Operations.hpp"
+#include "dd/Package.hpp"
+#include "dd/Reordering.hpp"
+#include "dd/Simulation.hpp"
+#include "dd/StaticOrdering.hpp"
+#include "ir/Permutation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "test_utils.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+namespace {
+/// Bell pairs between qubit i and i + n/2, which is exponentially large in the
+/// identity order, followed by some single-qubit and entangling gates
+qc::QuantumComputation pairedCircuit(const std::size_t nqubits) {
+  qc::QuantumComputation qc(nqubits);
+  const auto half = static_cast<qc::Qubit>(nqubits / 2U);
+  for (qc::Qubit i = 0U; i < half; ++i) {
+    qc.h(i);
+    qc.ry(0.1 * static_cast<double>(i + 1U), i + half);
+    qc.cx(i, i + half);
+  }
+  for (qc::Qubit i = 0U; i < half; ++i) {
+    qc.t(i);
+    qc.cz(i + half, i);
+  }
+  qc.swap(0, half);
+  qc.h(1);
+  qc.cx(1, half + 1U);
+  return qc;
+}
+
+void expectEqualVectors(const dd::CVec& lhs, const dd::CVec& rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (std::size_t i = 0U; i < lhs.size(); ++i) {
+    EXPECT_NEAR(lhs[i].real(), rhs[i].real(), 1e-10);
+    EXPECT_NEAR(lhs[i].imag(), rhs[i].imag(), 1e-10);
+  }
+}
+
+void expectEqualMatrices(const dd::CMat& lhs, const dd::CMat& rhs) {
+  ASSERT_EQ(lhs.size(), rhs.size());
+  for (std::size_t i = 0U; i < lhs.size(); ++i) {
+    expectEqualVectors(lhs[i], rhs[i]);
+  }
+}
+} // namespace
+
+TEST(DDReordering, SwapAdjacentLevelsOfState) {
+  constexpr std::size_t nqubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  std::mt19937_64 mt(42U);
+  const auto state =
+      dd->makeStateFromVector(dd::randomStateVector(nqubits, mt));
+  dd->incRef(state);
+
+  for (dd::Qubit level = 0U; level + 1U < nqubits; ++level) {
+    const auto swapped = dd::swapAdjacentLevels(state, level, *dd);
+    const auto expected = dd->applySwapGate({}, level, level + 1U, state);
+    expectEqualVectors(swapped.getVector(), expected.getVector());
+  }
+  EXPECT_THROW(dd::swapAdjacentLevels(state, nqubits - 1U, *dd),
+               std::invalid_argument);
+  dd->decRef(state);
+}
+
+TEST(DDReordering, SwapAdjacentLevelsOfMatrix) {
+  constexpr std::size_t nqubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  // the functionality skips levels on which it acts as the identity
+  qc::QuantumComputation qc(nqubits);
+  qc.h(1);
+  qc.cx(1, 0);
+  qc.t(0);
+  qc.ry(0.3, 3);
+  const auto u = dd::buildFunctionality(&qc, *dd);
+
+  for (dd::Qubit level = 0U; level + 1U < nqubits; ++level) {
+    const auto swapped = dd::swapAdjacentLevels(u, level, *dd);
+    const auto swap = dd->makeTwoQubitGateDD(dd::SWAP_MAT, level, level + 1U);
+    const auto expected = dd->multiply(dd->multiply(swap, u), swap);
+    expectEqualMatrices(swapped.getMatrix(nqubits),
+                        expected.getMatrix(nqubits));
+  }
+  dd->decRef(u);
+}
+
+TEST(DDReordering, SiftingFindsInterleavedOrder) {
+  constexpr std::size_t nqubits = 10U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto qc = pairedCircuit(nqubits);
+  const auto expected = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd);
+  dd->incRef(expected);
+
+  auto state = expected;
+  dd->incRef(state);
+  auto permutation = qc.outputPermutation;
+  dd::ReorderingMetadata metadata{};
+  const auto before = state.size();
+  const auto after = dd::sift(state, permutation, *dd, metadata);
+  EXPECT_EQ(after, state.size());
+  EXPECT_LT(4U * after, before);
+  EXPECT_GT(metadata.swaps, 0U);
+
+  // restoring the original order yields the original state
+  dd::changePermutation(state, permutation, qc.outputPermutation, *dd);
+  EXPECT_NEAR(dd->fidelity(state, expected), 1., 1e-10);
+  dd->decRef(state);
+  dd->decRef(expected);
+}
+
+TEST(DDReordering, WindowPermutationDoesNotIncreaseSize) {
+  constexpr std::size_t nqubits = 8U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto qc = pairedCircuit(nqubits);
+  const auto expected = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd);
+  dd->incRef(expected);
+
+  auto state = expected;
+  dd->incRef(state);
+  auto permutation = qc.outputPermutation;
+  dd::ReorderingMetadata metadata{};
+  const auto before = state.size();
+  const auto after = dd::windowPermutation(state, permutation, *dd, metadata);
+  EXPECT_LT(after, before);
+
+  dd::changePermutation(state, permutation, qc.outputPermutation, *dd);
+  EXPECT_NEAR(dd->fidelity(state, expected), 1., 1e-10);
+  dd->decRef(state);
+  dd->decRef(expected);
+}
+
+TEST(DDReordering, SimulateWithReordering) {
+  constexpr std::size_t nqubits = 10U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto qc = pairedCircuit(nqubits);
+  const auto expected = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd);
+  dd->incRef(expected);
+
+  for (const auto method :
+       {dd::ReorderingMethod::Sifting, dd::ReorderingMethod::Window}) {
+    dd::DynamicReordering strategy{};
+    strategy.method = method;
+    strategy.threshold = 16U;
+    dd::ReorderingMetadata metadata{};
+    const auto state = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd,
+                                    strategy, metadata);
+    dd->incRef(state);
+    EXPECT_GT(metadata.rounds, 0U);
+    EXPECT_GT(metadata.removedNodes, 0U);
+    EXPECT_NEAR(dd->fidelity(state, expected), 1., 1e-10);
+    dd->decRef(state);
+  }
+  dd->decRef(expected);
+}
+
+TEST(DDReordering, BuildFunctionalityWithReordering) {
+  constexpr std::size_t nqubits = 6U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto qc = pairedCircuit(nqubits);
+  const auto expected = dd::buildFunctionality(&qc, *dd);
+
+  dd::DynamicReordering strategy{};
+  strategy.threshold = 8U;
+  dd::ReorderingMetadata metadata{};
+  const auto u = dd::buildFunctionality(&qc, *dd, strategy, metadata);
+  EXPECT_GT(metadata.rounds, 0U);
+  expectEqualMatrices(u.getMatrix(nqubits), expected.getMatrix(nqubits));
+  dd->decRef(u);
+  dd->decRef(expected);
+}
+
+TEST(DDReordering, StaticOrderPlacesInteractingQubitsAdjacently) {
+  constexpr qc::Qubit nqubits = 8U;
+  constexpr qc::Qubit half = nqubits / 2U;
+  qc::QuantumComputation qc(nqubits);
+  for (qc::Qubit i = 0U; i < half; ++i) {
+    qc.h(i);
+    qc.cx(i, i + half);
+    qc.rz(0.2, i + half);
+    qc.cx(i + half, i);
+  }
+
+  const auto order = dd::proposeQubitOrder(qc);
+  ASSERT_EQ(order.size(), nqubits);
+  for (qc::Qubit i = 0U; i < half; ++i) {
+    const auto distance = static_cast<int>(order.at(i)) -
+                          static_cast<int>(order.at(i + half));
+    EXPECT_EQ(std::abs(distance), 1);
+  }
+  EXPECT_LT(dd::estimateDDSize(qc, order),
+            dd::estimateDDSize(qc, qc.initialLayout));
+
+  // circuits without interactions keep their layout
+  qc::QuantumComputation local(nqubits);
+  local.h(0);
+  local.t(3);
+  EXPECT_EQ(dd::proposeQubitOrder(local), local.initialLayout);
+}
+
+TEST(DDReordering, SimulateFromStaticOrder) {
+  constexpr std::size_t nqubits = 10U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto qc = pairedCircuit(nqubits);
+  const auto expected = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd);
+  dd->incRef(expected);
+
+  dd::DynamicReordering strategy{};
+  strategy.staticOrder = true;
+  dd::ReorderingMetadata metadata{};
+  const auto state = dd::simulate(&qc, dd->makeZeroState(nqubits), *dd,
+                                  strategy, metadata);
+  dd->incRef(state);
+  EXPECT_EQ(metadata.rounds, 0U);
+  EXPECT_NEAR(dd->fidelity(state, expected), 1., 1e-10);
+  dd->decRef(state);
+  dd->decRef(expected);
+
+  const auto u = dd::buildFunctionality(&qc, *dd, strategy, metadata);
+  const auto v = dd::buildFunctionality(&qc, *dd);
+  const auto product = dd->multiply(dd->conjugateTranspose(u), v);
+  EXPECT_TRUE(dd->isCloseToIdentity(product));
+  dd->decRef(u);
+  dd->decRef(v);
+}
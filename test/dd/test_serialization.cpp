@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#include "dd/Checkpoint.hpp"
+#include "dd/DDDefinitions.hpp"
+#include "dd/FunctionalityConstruction.hpp"
+#include "dd/Node.hpp"
+#include "dd/Package.hpp"
+#include "dd/RealNumber.hpp"
+#include "dd/Serialization.hpp"
+#include "dd/Simulation.hpp"
+#include "ir/QuantumComputation.hpp"
+#include "test_utils.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+dd::vEdge randomState(const std::size_t nqubits, dd::Package<>& dd) {
+  std::mt19937_64 mt(4242U);
+  return dd.makeStateFromVector(dd::randomStateVector(nqubits, mt));
+}
+
+qc::QuantumComputation randomCircuit(const std::size_t nqubits) {
+  qc::QuantumComputation qc(nqubits);
+  std::mt19937_64 mt(2424U);
+  std::uniform_real_distribution<dd::fp> dist(0., 2. * dd::PI);
+  for (qc::Qubit q = 0U; q < nqubits; ++q) {
+    qc.h(q);
+    qc.rz(dist(mt), q);
+  }
+  for (qc::Qubit q = 0U; q + 1U < nqubits; ++q) {
+    qc.cx(q, q + 1U);
+    qc.ry(dist(mt), q + 1U);
+  }
+  return qc;
+}
+
+/// A random circuit followed by a virtual SWAP and another layer of rotations
+qc::QuantumComputation checkpointedCircuit(const std::size_t nqubits) {
+  auto qc = randomCircuit(nqubits);
+  std::mt19937_64 mt(4242U);
+  std::uniform_real_distribution<dd::fp> dist(0., 2. * dd::PI);
+  qc.swap(0U, static_cast<qc::Qubit>(nqubits - 1U));
+  for (qc::Qubit q = 0U; q < nqubits; ++q) {
+    qc.rx(dist(mt), q);
+  }
+  return qc;
+}
+} // namespace
+
+class CompactSerialization : public testing::TestWithParam<bool> {};
+
+INSTANTIATE_TEST_SUITE_P(DDSerialization, CompactSerialization,
+                         testing::Bool(),
+                         [](const testing::TestParamInfo<bool>& paramInfo) {
+                           return paramInfo.param ? "compressed"
+                                                  : "uncompressed";
+                         });
+
+TEST_P(CompactSerialization, VectorRoundTrip) {
+  constexpr std::size_t nqubits = 6U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto state = randomState(nqubits, *dd);
+  dd->incRef(state);
+
+  std::stringstream ss{};
+  dd::serializeCompact(state, ss, GetParam());
+
+  // loading into the same package yields the very same DD
+  const auto loaded = dd::deserializeCompact<dd::vNode>(ss, *dd);
+  EXPECT_EQ(loaded, state);
+
+  // loading into a fresh package yields the same vector
+  auto other = std::make_unique<dd::Package<>>(nqubits);
+  ss.clear();
+  ss.seekg(0);
+  const auto copy = dd::deserializeCompact<dd::vNode>(ss, *other);
+  EXPECT_EQ(copy.size(), state.size());
+  const auto expected = state.getVector();
+  const auto actual = copy.getVector();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0U; i < expected.size(); ++i) {
+    EXPECT_NEAR(actual[i].real(), expected[i].real(), dd::RealNumber::eps);
+    EXPECT_NEAR(actual[i].imag(), expected[i].imag(), dd::RealNumber::eps);
+  }
+  dd->decRef(state);
+}
+
+TEST_P(CompactSerialization, MatrixFileRoundTrip) {
+  constexpr std::size_t nqubits = 5U;
+  const auto qc = randomCircuit(nqubits);
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto func = dd::buildFunctionality(&qc, *dd);
+
+  const auto filename =
+      (std::filesystem::temp_directory_path() /
+       ("mqt_core_dd_serialization_" + std::to_string(GetParam()) + ".bin"))
+          .string();
+  dd::serializeCompact(func, filename, GetParam());
+
+  const auto loaded = dd::deserializeCompact<dd::mNode>(filename, *dd);
+  EXPECT_EQ(loaded, func);
+
+  auto other = std::make_unique<dd::Package<>>(nqubits);
+  const auto copy = dd::deserializeCompact<dd::mNode>(filename, *other);
+  EXPECT_EQ(copy.size(), func.size());
+  EXPECT_NEAR(other->fidelity(other->makeZeroState(nqubits),
+                              other->multiply(copy, other->makeZeroState(
+                                                        nqubits))),
+              dd->fidelity(dd->makeZeroState(nqubits),
+                           dd->multiply(func, dd->makeZeroState(nqubits))),
+              1e-10);
+  std::filesystem::remove(filename);
+  dd->decRef(func);
+}
+
+TEST(DDSerialization, CompactTerminal) {
+  auto dd = std::make_unique<dd::Package<>>(1U);
+  const auto one = dd::vEdge::one();
+  std::stringstream ss{};
+  dd::serializeCompact(one, ss);
+  EXPECT_EQ(dd::deserializeCompact<dd::vNode>(ss, *dd), one);
+}
+
+TEST(DDSerialization, CompactRejectsInvalidData) {
+  constexpr std::size_t nqubits = 4U;
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  const auto state = randomState(nqubits, *dd);
+  dd->incRef(state);
+  std::stringstream ss{};
+  dd::serializeCompact(state, ss);
+  const auto data = ss.str();
+
+  // corrupted payload
+  auto corrupted = data;
+  corrupted.back() = static_cast<char>(corrupted.back() ^ 0x1);
+  EXPECT_THROW(dd::deserializeCompact<dd::vNode>(corrupted.data(),
+                                                 corrupted.size(), *dd),
+               std::runtime_error);
+
+  // truncated data
+  EXPECT_THROW(
+      dd::deserializeCompact<dd::vNode>(data.data(), data.size() - 1U, *dd),
+      std::runtime_error);
+
+  // wrong version
+  auto header = dd::CompactSerializationHeader{};
+  auto wrongVersion = data;
+  header.version = dd::COMPACT_SERIALIZATION_VERSION + 1U;
+  std::memcpy(wrongVersion.data() + offsetof(dd::CompactSerializationHeader,
+                                             version),
+              &header.version, sizeof(header.version));
+  EXPECT_THROW(dd::deserializeCompact<dd::vNode>(wrongVersion.data(),
+                                                 wrongVersion.size(), *dd),
+               std::runtime_error);
+
+  // vector data cannot be loaded as matrix
+  EXPECT_THROW(
+      dd::deserializeCompact<dd::mNode>(data.data(), data.size(), *dd),
+      std::runtime_error);
+  dd->decRef(state);
+}
+
+class SimulationCheckpointing : public testing::Test {
+protected:
+  void SetUp() override {
+    const auto* info = testing::UnitTest::GetInstance()->current_test_info();
+    filename = (std::filesystem::temp_directory_path() /
+                (std::string("mqt_core_dd_") + info->name() + ".ckpt"))
+                   .string();
+    std::filesystem::remove(filename);
+  }
+  void TearDown() override { std::filesystem::remove(filename); }
+
+  std::string filename;
+};
+
+TEST_F(SimulationCheckpointing, ResumeSimulation) {
+  constexpr std::size_t nqubits = 5U;
+  const auto qc = checkpointedCircuit(nqubits);
+  constexpr std::size_t interval = 4U;
+  ASSERT_GT(qc.getNops(), interval);
+
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  auto in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  const auto reference = dd::simulate(&qc, in, *dd);
+  const auto expected = reference.getVector();
+
+  in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  const auto checkpointed =
+      dd::simulate(&qc, in, *dd, dd::CheckpointOptions{filename, interval});
+  EXPECT_EQ(checkpointed, reference);
+  ASSERT_TRUE(std::filesystem::exists(filename));
+
+  // the last checkpoint is taken at the last multiple of the interval
+  auto restored = dd::loadCheckpoint(filename, *dd);
+  EXPECT_EQ(restored.numOperations, qc.getNops());
+  EXPECT_EQ(restored.nextOperation,
+            ((qc.getNops() - 1U) / interval) * interval);
+  EXPECT_EQ(restored.permutation.at(0U), nqubits - 1U);
+  dd->decRef(restored.state);
+
+  // resuming in a fresh package yields the same final state
+  auto other = std::make_unique<dd::Package<>>(nqubits);
+  in = other->makeZeroState(nqubits);
+  other->incRef(in);
+  const auto resumed = dd::simulate(
+      &qc, in, *other, dd::CheckpointOptions{filename, interval, true});
+  const auto actual = resumed.getVector();
+  ASSERT_EQ(actual.size(), expected.size());
+  for (std::size_t i = 0U; i < expected.size(); ++i) {
+    EXPECT_NEAR(actual[i].real(), expected[i].real(), 1e-10);
+    EXPECT_NEAR(actual[i].imag(), expected[i].imag(), 1e-10);
+  }
+  other->decRef(resumed);
+  dd->decRef(checkpointed);
+  dd->decRef(reference);
+}
+
+TEST_F(SimulationCheckpointing, RejectsCheckpointOfOtherCircuit) {
+  constexpr std::size_t nqubits = 4U;
+  const auto qc = checkpointedCircuit(nqubits);
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  auto in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  const auto result =
+      dd::simulate(&qc, in, *dd, dd::CheckpointOptions{filename, 3U});
+  dd->decRef(result);
+
+  auto other = qc;
+  other.x(0U);
+  in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  EXPECT_THROW(dd::simulate(&other, in, *dd,
+                            dd::CheckpointOptions{filename, 3U, true}),
+               std::invalid_argument);
+  dd->decRef(in);
+}
+
+TEST_F(SimulationCheckpointing, RejectsCheckpointOfCircuitWithSameSize) {
+  constexpr std::size_t nqubits = 4U;
+  const auto qc = checkpointedCircuit(nqubits);
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  auto in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  const auto result =
+      dd::simulate(&qc, in, *dd, dd::CheckpointOptions{filename, 3U});
+  dd->decRef(result);
+
+  auto otherParameter = qc;
+  otherParameter.at(qc.getNops() - 1U)->setParameter({0.5});
+  auto otherTarget = qc;
+  otherTarget.at(0U)->setTargets({1U});
+  auto otherLayout = qc;
+  std::swap(otherLayout.initialLayout[0U], otherLayout.initialLayout[1U]);
+  for (const auto* other : {&otherParameter, &otherTarget, &otherLayout}) {
+    ASSERT_EQ(other->getNops(), qc.getNops());
+    in = dd->makeZeroState(nqubits);
+    dd->incRef(in);
+    EXPECT_THROW(dd::simulate(other, in, *dd,
+                              dd::CheckpointOptions{filename, 3U, true}),
+                 std::invalid_argument);
+    dd->decRef(in);
+  }
+}
+
+TEST_F(SimulationCheckpointing, ResumeSampling) {
+  constexpr std::size_t nqubits = 4U;
+  auto qc = checkpointedCircuit(nqubits);
+  qc.measureAll();
+  constexpr std::size_t shots = 256U;
+  constexpr std::size_t seed = 1234U;
+
+  auto dd = std::make_unique<dd::Package<>>(nqubits);
+  auto in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  const auto expected = dd::sample(&qc, in, *dd, shots, seed);
+
+  in = dd->makeZeroState(nqubits);
+  dd->incRef(in);
+  const auto checkpointed = dd::sample(&qc, in, *dd, shots, seed,
+                                       dd::CheckpointOptions{filename, 5U});
+  EXPECT_EQ(checkpointed, expected);
+  ASSERT_TRUE(std::filesystem::exists(filename));
+
+  auto other = std::make_unique<dd::Package<>>(nqubits);
+  in = other->makeZeroState(nqubits);
+  other->incRef(in);
+  const auto resumed = dd::sample(&qc, in, *other, shots, seed,
+                                  dd::CheckpointOptions{filename, 5U, true});
+  EXPECT_EQ(resumed, expected);
+}
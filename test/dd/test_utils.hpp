@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024 Chair for Design Automation, TUM
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Licensed under the MIT License
+ */
+
+#pragma once
+
+#include "dd/DDDefinitions.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <random>
+
+namespace dd {
+
+/// A normalized state vector with normally distributed amplitudes
+inline CVec randomStateVector(const std::size_t nqubits, std::mt19937_64& mt) {
+  std::normal_distribution<fp> dist{};
+  CVec state(1ULL << nqubits);
+  fp norm = 0.;
+  for (auto& amplitude : state) {
+    amplitude = {dist(mt), dist(mt)};
+    norm += std::norm(amplitude);
+  }
+  for (auto& amplitude : state) {
+    amplitude /= std::sqrt(norm);
+  }
+  return state;
+}
+
+} // namespace dd